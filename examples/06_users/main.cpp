@@ -31,17 +31,14 @@ int main(int argc, char *argv[])
 	/*
 	// It is possible to provide a custom callback to validate the user and password
 	// send by the client. The implementation below is the default implementation of not defined.
-	// Overwriting this callback can be used to obtain a hash of the password sent by the client and
-	// compare it to a locally stored hash. In this way we avoid storing user's passwords which
-	// is considered an insecure practice. A function pointer can also be used as validation callback.
+	// The server only keeps a salted hash of the keys passed to addUser, which can be obtained
+	// with userKey to store it and restore it later with addUserHash. Overwriting this callback
+	// can be used to validate against an external user database. Successful logins are
+	// remembered for a short time (see setLoginCacheTimeout) so reconnecting clients do not
+	// call it again. A function pointer can also be used as validation callback.
 	server.setUserValidationCallback(
 	[&server](const QString &strUserName, const QString &strPassword) {
-		if (!server.userExists(strUserName))
-		{
-			return false;
-		}
-		QString strKey = server.userKey(strUserName);
-		return strKey.compare(strPassword, Qt::CaseSensitive) == 0;
+		return server.verifyUserKey(strUserName, strPassword);
 	});
 	*/
 
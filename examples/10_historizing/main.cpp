@@ -50,6 +50,10 @@ int main(int argc, char* argv[])
 	// set the historizer
 	// NOTE : historizer must live at least as long as server
 	server.setHistorizer(historizer);
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	// record triggered events too (both historizers implement the optional events API)
+	server.setEventHistorizing(true);
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 	// add test variables
 	QTimer timer;
 	QUaFolderObject* objsFolder = server.objectsFolder();
@@ -30,8 +30,8 @@ bool QUaInMemoryHistorizer::updateHistoryData(
 
 bool QUaInMemoryHistorizer::removeHistoryData(
 	const QString& strNodeId,
-	const QDateTime& timeStart,
-	const QDateTime& timeEnd,
+	const QUaDateTime& timeStart,
+	const QUaDateTime& timeEnd,
 	QQueue<QUaLog>& logOut)
 {
 	Q_ASSERT(timeStart <= timeEnd);
@@ -60,7 +60,7 @@ bool QUaInMemoryHistorizer::removeHistoryData(
 	return true;
 }
 
-QDateTime QUaInMemoryHistorizer::firstTimestamp(
+QUaDateTime QUaInMemoryHistorizer::firstTimestamp(
 	const QString& strNodeId,
 	QQueue<QUaLog>& logOut) const
 {
@@ -73,12 +73,12 @@ QDateTime QUaInMemoryHistorizer::firstTimestamp(
 			QUaLogLevel::Error,
 			QUaLogCategory::History
 			});
-		return QDateTime();
+		return QUaDateTime();
 	}
 	return m_database[strNodeId].firstKey();
 }
 
-QDateTime QUaInMemoryHistorizer::lastTimestamp(
+QUaDateTime QUaInMemoryHistorizer::lastTimestamp(
 	const QString& strNodeId,
 	QQueue<QUaLog>& logOut) const
 {
@@ -91,14 +91,14 @@ QDateTime QUaInMemoryHistorizer::lastTimestamp(
 			QUaLogLevel::Error,
 			QUaLogCategory::History
 			});
-		return QDateTime();
+		return QUaDateTime();
 	}
 	return m_database[strNodeId].lastKey();
 }
 
 bool QUaInMemoryHistorizer::hasTimestamp(
 	const QString& strNodeId,
-	const QDateTime& timestamp,
+	const QUaDateTime& timestamp,
 	QQueue<QUaLog>& logOut) const
 {
 	if (!m_database.contains(strNodeId))
@@ -115,9 +115,9 @@ bool QUaInMemoryHistorizer::hasTimestamp(
 	return m_database[strNodeId].contains(timestamp);
 }
 
-QDateTime QUaInMemoryHistorizer::findTimestamp(
+QUaDateTime QUaInMemoryHistorizer::findTimestamp(
 	const QString& strNodeId,
-	const QDateTime& timestamp,
+	const QUaDateTime& timestamp,
 	const QUaHistoryBackend::TimeMatch& match,
 	QQueue<QUaLog>& logOut) const
 {
@@ -130,10 +130,10 @@ QDateTime QUaInMemoryHistorizer::findTimestamp(
 			QUaLogLevel::Error,
 			QUaLogCategory::History
 			});
-		return QDateTime();
+		return QUaDateTime();
 	}
 	// NOTE : the database might or might not contain the input timestamp
-	QDateTime time;
+	QUaDateTime time;
 	auto& table = m_database[strNodeId];
 	switch (match)
 	{
@@ -180,8 +180,8 @@ QDateTime QUaInMemoryHistorizer::findTimestamp(
 
 quint64 QUaInMemoryHistorizer::numDataPointsInRange(
 	const QString& strNodeId,
-	const QDateTime& timeStart,
-	const QDateTime& timeEnd,
+	const QUaDateTime& timeStart,
+	const QUaDateTime& timeEnd,
 	QQueue<QUaLog>& logOut) const
 {
 	if (!m_database.contains(strNodeId))
@@ -209,7 +209,7 @@ quint64 QUaInMemoryHistorizer::numDataPointsInRange(
 
 QVector<QUaHistoryDataPoint> QUaInMemoryHistorizer::readHistoryData(
 	const QString& strNodeId,
-	const QDateTime& timeStart,
+	const QUaDateTime& timeStart,
 	const quint64& numPointsToRead,
 	QQueue<QUaLog>& logOut) const
 {
@@ -251,4 +251,70 @@ QVector<QUaHistoryDataPoint> QUaInMemoryHistorizer::readHistoryData(
 	return points;
 }
 
+bool QUaInMemoryHistorizer::writeHistoryEventPoint(
+	const QUaHistoryEventPoint& eventPoint,
+	QQueue<QUaLog>& logOut)
+{
+	Q_UNUSED(logOut);
+	int index = m_events.count();
+	m_events << eventPoint;
+	m_eventsByTime.insert(eventPoint.timestamp, index);
+	m_eventsBySource[eventPoint.strSourceNodeId].insert(eventPoint.timestamp, index);
+	m_eventsByType  [eventPoint.strEventType   ].insert(eventPoint.timestamp, index);
+	return true;
+}
+
+QVector<QUaHistoryEventPoint> QUaInMemoryHistorizer::readHistoryEvents(
+	const QUaDateTime& timeStart,
+	const QUaDateTime& timeEnd,
+	const QUaHistoryEventFilter& filter,
+	const quint64& numEventsToRead,
+	QQueue<QUaLog>& logOut) const
+{
+	Q_UNUSED(logOut);
+	QVector<QUaHistoryEventPoint> events;
+	// use the most selective index, the rest of the filter is checked per event
+	const EventIndex * index = &m_eventsByTime;
+	if (!filter.strSourceNodeId.isEmpty())
+	{
+		auto iter = m_eventsBySource.find(filter.strSourceNodeId);
+		if (iter == m_eventsBySource.end())
+		{
+			return events;
+		}
+		index = &iter.value();
+	}
+	else if (!filter.strEventType.isEmpty())
+	{
+		auto iter = m_eventsByType.find(filter.strEventType);
+		if (iter == m_eventsByType.end())
+		{
+			return events;
+		}
+		index = &iter.value();
+	}
+	for (auto it = index->lowerBound(timeStart); it != index->end(); it++)
+	{
+		if (timeEnd.isValid() && it.key() > timeEnd)
+		{
+			break;
+		}
+		const QUaHistoryEventPoint& eventPoint = m_events.at(it.value());
+		if (!filter.strEventType.isEmpty() && eventPoint.strEventType != filter.strEventType)
+		{
+			continue;
+		}
+		if (eventPoint.severity < filter.minSeverity)
+		{
+			continue;
+		}
+		events << eventPoint;
+		if (numEventsToRead > 0 && static_cast<quint64>(events.count()) >= numEventsToRead)
+		{
+			break;
+		}
+	}
+	return events;
+}
+
 #endif // UA_ENABLE_HISTORIZING
\ No newline at end of file
@@ -27,19 +27,19 @@ public:
 	// remove an existing node's data points within a range, return true on success
 	bool removeHistoryData(
 		const QString& strNodeId,
-		const QDateTime& timeStart,
-		const QDateTime& timeEnd,
+		const QUaDateTime& timeStart,
+		const QUaDateTime& timeEnd,
 		QQueue<QUaLog>& logOut
 	);
 	// required API for QUaServer::setHistorizer
 	// return the timestamp of the first sample available for the given node
-	QDateTime firstTimestamp(
+	QUaDateTime firstTimestamp(
 		const QString& strNodeId,
 		QQueue<QUaLog>& logOut
 	) const;
 	// required API for QUaServer::setHistorizer
 	// return the timestamp of the latest sample available for the given node
-	QDateTime lastTimestamp(
+	QUaDateTime lastTimestamp(
 		const QString& strNodeId,
 		QQueue<QUaLog>& logOut
 	) const;
@@ -47,14 +47,14 @@ public:
 	// return true if given timestamp is available for the given node
 	bool hasTimestamp(
 		const QString& strNodeId,
-		const QDateTime& timestamp,
+		const QUaDateTime& timestamp,
 		QQueue<QUaLog>& logOut
 	) const;
 	// required API for QUaServer::setHistorizer
 	// return a timestamp matching the criteria for the given node
-	QDateTime findTimestamp(
+	QUaDateTime findTimestamp(
 		const QString& strNodeId,
-		const QDateTime& timestamp,
+		const QUaDateTime& timestamp,
 		const QUaHistoryBackend::TimeMatch& match,
 		QQueue<QUaLog>& logOut
 	) const;
@@ -62,17 +62,33 @@ public:
 	// return the number for data points within a time range for the given node
 	quint64 numDataPointsInRange(
 		const QString& strNodeId,
-		const QDateTime& timeStart,
-		const QDateTime& timeEnd,
+		const QUaDateTime& timeStart,
+		const QUaDateTime& timeEnd,
 		QQueue<QUaLog>& logOut
 	) const;
 	// required API for QUaServer::setHistorizer
 	// return the numPointsToRead data points for the given node from the given start time
 	QVector<QUaHistoryDataPoint> readHistoryData(
-		const QString   &strNodeId,
-		const QDateTime &timeStart,
-		const quint64   &numPointsToRead,
-		QQueue<QUaLog>  &logOut
+		const QString     &strNodeId,
+		const QUaDateTime &timeStart,
+		const quint64     &numPointsToRead,
+		QQueue<QUaLog>    &logOut
+	) const;
+
+	// optional events API for QUaServer::setEventHistorizing
+	// write event to backend, return true on success
+	bool writeHistoryEventPoint(
+		const QUaHistoryEventPoint &eventPoint,
+		QQueue<QUaLog>             &logOut
+	);
+	// optional events API for QUaServer::setEventHistorizing
+	// return the events matching the filter within the time range, ordered by time
+	QVector<QUaHistoryEventPoint> readHistoryEvents(
+		const QUaDateTime           &timeStart,
+		const QUaDateTime           &timeEnd,
+		const QUaHistoryEventFilter &filter,
+		const quint64               &numEventsToRead,
+		QQueue<QUaLog>              &logOut
 	) const;
 
 private:
@@ -82,8 +98,15 @@ private:
 		quint32   status;
 	};
 	// NOTE : use a map to store the data points of a single node, ordered by time
-	typedef QMap<QDateTime, DataPoint> DataPointTable;
+	typedef QMap<QUaDateTime, DataPoint> DataPointTable;
 	QHash<QString, DataPointTable> m_database;
+	// NOTE : events are stored once and indexed by time, by source and by type,
+	//        each index maps the event time to the position in m_events
+	typedef QMultiMap<QUaDateTime, int> EventIndex;
+	QVector<QUaHistoryEventPoint> m_events;
+	EventIndex                    m_eventsByTime;
+	QHash<QString, EventIndex>    m_eventsBySource;
+	QHash<QString, EventIndex>    m_eventsByType;
 };
 
 #endif // UA_ENABLE_HISTORIZING
@@ -6,6 +6,7 @@
 
 #include <QSqlError>
 #include <QSqlRecord>
+#include <QDataStream>
 
 // map supported types
 QHash<int, QString> QUaSqliteHistorizer::m_hashTypes = {
@@ -34,6 +35,7 @@ QHash<int, QString> QUaSqliteHistorizer::m_hashTypes = {
 QUaSqliteHistorizer::QUaSqliteHistorizer()
 {
 	m_timeoutTransaction = 1000;
+	m_eventTableExists   = false;
 	QObject::connect(&m_timerTransaction, &QTimer::timeout, &m_timerTransaction,
 	[this]() {
 		// stop timer until next write request
@@ -77,6 +79,9 @@ bool QUaSqliteHistorizer::setSqliteDbName(
 {
 	// set internally
 	m_strSqliteDbName = strSqliteDbName;
+	// events statements are bound to the previous database
+	m_eventTableExists = false;
+	m_readHistoryEvents.clear();
 	// create and test open database handle
 	QSqlDatabase db;
 	if (!this->getOpenedDatabase(db, logOut))
@@ -165,8 +170,8 @@ bool QUaSqliteHistorizer::updateHistoryData(
 
 bool QUaSqliteHistorizer::removeHistoryData(
 	const QString& strNodeId,
-	const QDateTime& timeStart,
-	const QDateTime& timeEnd,
+	const QUaDateTime& timeStart,
+	const QUaDateTime& timeEnd,
 	QQueue<QUaLog>& logOut
 )
 {
@@ -178,7 +183,7 @@ bool QUaSqliteHistorizer::removeHistoryData(
 	return false;
 }
 
-QDateTime QUaSqliteHistorizer::firstTimestamp(
+QUaDateTime QUaSqliteHistorizer::firstTimestamp(
 	const QString& strNodeId,
 	QQueue<QUaLog>& logOut
 )
@@ -187,13 +192,13 @@ QDateTime QUaSqliteHistorizer::firstTimestamp(
 	QSqlDatabase db;
 	if (!this->getOpenedDatabase(db, logOut))
 	{
-		return QDateTime();
+		return QUaDateTime();
 	}
 	// check type table exists
 	bool typeTableExists;
 	if (!this->tableExists(db, strNodeId, typeTableExists, logOut))
 	{
-		return QDateTime();
+		return QUaDateTime();
 	}
 	if (!typeTableExists)
 	{
@@ -204,7 +209,7 @@ QDateTime QUaSqliteHistorizer::firstTimestamp(
 			QUaLogLevel::Error,
 			QUaLogCategory::History
 			});
-		return QDateTime();
+		return QUaDateTime();
 	}
 	Q_ASSERT(db.isValid() && db.isOpen());
 	// get prepared statement cache
@@ -219,7 +224,7 @@ QDateTime QUaSqliteHistorizer::firstTimestamp(
 			QUaLogLevel::Error,
 			QUaLogCategory::Serialization
 			});
-		return QDateTime();
+		return QUaDateTime();
 	}
 	if (!query.next())
 	{
@@ -231,17 +236,17 @@ QDateTime QUaSqliteHistorizer::firstTimestamp(
 			QUaLogLevel::Error,
 			QUaLogCategory::Serialization
 			});
-		return QDateTime();
+		return QUaDateTime();
 	}
 	// get time key
 	QSqlRecord rec = query.record();
 	int timeKeyCol = rec.indexOf("Time");
 	Q_ASSERT(timeKeyCol >= 0);
 	auto timeInt = query.value(timeKeyCol).toLongLong();
-	return QDateTime::fromMSecsSinceEpoch(timeInt);
+	return QUaDateTime(static_cast<UA_DateTime>(timeInt));
 }
 
-QDateTime QUaSqliteHistorizer::lastTimestamp(
+QUaDateTime QUaSqliteHistorizer::lastTimestamp(
 	const QString& strNodeId,
 	QQueue<QUaLog>& logOut
 )
@@ -250,13 +255,13 @@ QDateTime QUaSqliteHistorizer::lastTimestamp(
 	QSqlDatabase db;
 	if (!this->getOpenedDatabase(db, logOut))
 	{
-		return QDateTime();
+		return QUaDateTime();
 	}
 	// check type table exists
 	bool typeTableExists;
 	if (!this->tableExists(db, strNodeId, typeTableExists, logOut))
 	{
-		return QDateTime();
+		return QUaDateTime();
 	}
 	if (!typeTableExists)
 	{
@@ -267,7 +272,7 @@ QDateTime QUaSqliteHistorizer::lastTimestamp(
 			QUaLogLevel::Error,
 			QUaLogCategory::History
 			});
-		return QDateTime();
+		return QUaDateTime();
 	}
 	Q_ASSERT(db.isValid() && db.isOpen());
 	// get prepared statement cache
@@ -282,7 +287,7 @@ QDateTime QUaSqliteHistorizer::lastTimestamp(
 			QUaLogLevel::Error,
 			QUaLogCategory::Serialization
 			});
-		return QDateTime();
+		return QUaDateTime();
 	}
 	if (!query.next())
 	{
@@ -294,19 +299,19 @@ QDateTime QUaSqliteHistorizer::lastTimestamp(
 			QUaLogLevel::Error,
 			QUaLogCategory::Serialization
 			});
-		return QDateTime();
+		return QUaDateTime();
 	}
 	// get time key
 	QSqlRecord rec = query.record();
 	int timeKeyCol = rec.indexOf("Time");
 	Q_ASSERT(timeKeyCol >= 0);
 	auto timeInt = query.value(timeKeyCol).toLongLong();
-	return QDateTime::fromMSecsSinceEpoch(timeInt);
+	return QUaDateTime(static_cast<UA_DateTime>(timeInt));
 }
 
 bool QUaSqliteHistorizer::hasTimestamp(
 	const QString& strNodeId,
-	const QDateTime& timestamp,
+	const QUaDateTime& timestamp,
 	QQueue<QUaLog>& logOut
 )
 {
@@ -335,7 +340,7 @@ bool QUaSqliteHistorizer::hasTimestamp(
 	}
 	Q_ASSERT(db.isValid() && db.isOpen());
 	QSqlQuery& query = m_prepStmts[strNodeId].hasTimestamp;
-	query.bindValue(0, timestamp.toMSecsSinceEpoch());
+	query.bindValue(0, static_cast<qlonglong>(timestamp.ticks()));
 	if (!query.exec())
 	{
 		logOut << QUaLog({
@@ -367,9 +372,9 @@ bool QUaSqliteHistorizer::hasTimestamp(
 	return found;
 }
 
-QDateTime QUaSqliteHistorizer::findTimestamp(
+QUaDateTime QUaSqliteHistorizer::findTimestamp(
 	const QString& strNodeId,
-	const QDateTime& timestamp,
+	const QUaDateTime& timestamp,
 	const QUaHistoryBackend::TimeMatch& match,
 	QQueue<QUaLog>& logOut
 )
@@ -378,13 +383,13 @@ QDateTime QUaSqliteHistorizer::findTimestamp(
 	QSqlDatabase db;
 	if (!this->getOpenedDatabase(db, logOut))
 	{
-		return QDateTime();
+		return QUaDateTime();
 	}
 	// check type table exists
 	bool typeTableExists;
 	if (!this->tableExists(db, strNodeId, typeTableExists, logOut))
 	{
-		return QDateTime();
+		return QUaDateTime();
 	}
 	if (!typeTableExists)
 	{
@@ -395,7 +400,7 @@ QDateTime QUaSqliteHistorizer::findTimestamp(
 			QUaLogLevel::Error,
 			QUaLogCategory::History
 			});
-		return QDateTime();
+		return QUaDateTime();
 	}
 	Q_ASSERT(db.isValid() && db.isOpen());
 	// get correct query
@@ -419,7 +424,7 @@ QDateTime QUaSqliteHistorizer::findTimestamp(
 	break;
 	}
 	// set reference time
-	query.bindValue(0, timestamp.toMSecsSinceEpoch());
+	query.bindValue(0, static_cast<qlonglong>(timestamp.ticks()));
 	if (!query.exec())
 	{
 		logOut << QUaLog({
@@ -430,7 +435,7 @@ QDateTime QUaSqliteHistorizer::findTimestamp(
 			QUaLogLevel::Error,
 			QUaLogCategory::Serialization
 			});
-		return QDateTime();
+		return QUaDateTime();
 	}
 	// if there is none return either first or last
 	if (!query.next())
@@ -459,13 +464,13 @@ QDateTime QUaSqliteHistorizer::findTimestamp(
 	int timeKeyCol = rec.indexOf("Time");
 	Q_ASSERT(timeKeyCol >= 0);
 	auto timeInt = query.value(timeKeyCol).toLongLong();
-	return QDateTime::fromMSecsSinceEpoch(timeInt);
+	return QUaDateTime(static_cast<UA_DateTime>(timeInt));
 }
 
 quint64 QUaSqliteHistorizer::numDataPointsInRange(
 	const QString& strNodeId,
-	const QDateTime& timeStart,
-	const QDateTime& timeEnd,
+	const QUaDateTime& timeStart,
+	const QUaDateTime& timeEnd,
 	QQueue<QUaLog>& logOut)
 {
 	// get database handle
@@ -496,13 +501,13 @@ quint64 QUaSqliteHistorizer::numDataPointsInRange(
 	if (timeEnd.isValid())
 	{
 		query = m_prepStmts[strNodeId].numDataPointsInRangeEndValid;
-		query.bindValue(0, timeStart.toMSecsSinceEpoch());
-		query.bindValue(1, timeEnd.toMSecsSinceEpoch());
+		query.bindValue(0, static_cast<qlonglong>(timeStart.ticks()));
+		query.bindValue(1, static_cast<qlonglong>(timeEnd.ticks()));
 	}
 	else
 	{
 		query = m_prepStmts[strNodeId].numDataPointsInRangeEndInvalid;
-		query.bindValue(0, timeStart.toMSecsSinceEpoch());
+		query.bindValue(0, static_cast<qlonglong>(timeStart.ticks()));
 	}
 	if (!query.exec())
 	{
@@ -536,7 +541,7 @@ quint64 QUaSqliteHistorizer::numDataPointsInRange(
 
 QVector<QUaHistoryDataPoint> QUaSqliteHistorizer::readHistoryData(
 	const QString& strNodeId,
-	const QDateTime& timeStart,
+	const QUaDateTime& timeStart,
 	const quint64& numPointsToRead,
 	QQueue<QUaLog>& logOut)
 {
@@ -566,7 +571,7 @@ QVector<QUaHistoryDataPoint> QUaSqliteHistorizer::readHistoryData(
 	}
 	Q_ASSERT(db.isValid() && db.isOpen());
 	QSqlQuery& query = m_prepStmts[strNodeId].readHistoryData;
-	query.bindValue(0, timeStart.toMSecsSinceEpoch());
+	query.bindValue(0, static_cast<qlonglong>(timeStart.ticks()));
 	query.bindValue(1, numPointsToRead);
 	if (!query.exec())
 	{
@@ -590,7 +595,7 @@ QVector<QUaHistoryDataPoint> QUaSqliteHistorizer::readHistoryData(
 		Q_ASSERT(valueKeyCol >= 0);
 		Q_ASSERT(statusKeyCol >= 0);
 		auto timeInt = query.value(timeKeyCol).toLongLong();
-		auto time = QDateTime::fromMSecsSinceEpoch(timeInt);
+		auto time = QUaDateTime(static_cast<UA_DateTime>(timeInt));
 		auto value = query.value(valueKeyCol);
 		auto status = query.value(statusKeyCol).toUInt();
 		points << QUaHistoryDataPoint({
@@ -605,6 +610,208 @@ QVector<QUaHistoryDataPoint> QUaSqliteHistorizer::readHistoryData(
 	return points;
 }
 
+bool QUaSqliteHistorizer::writeHistoryEventPoint(
+	const QUaHistoryEventPoint& eventPoint,
+	QQueue<QUaLog>& logOut
+)
+{
+	// check if there are any queued logs that need to be reported
+	if (!m_deferedLogOut.isEmpty())
+	{
+		logOut << m_deferedLogOut;
+		m_deferedLogOut.clear();
+	}
+	// get database handle
+	QSqlDatabase db;
+	if (!this->getOpenedDatabase(db, logOut))
+	{
+		return false;
+	}
+	// handle transactions
+	if (!this->handleTransactions(db, logOut))
+	{
+		return false;
+	}
+	// create table if not exists
+	if (!m_eventTableExists && !this->createEventTable(db, logOut))
+	{
+		return false;
+	}
+	// serialize fields, skip types that cannot be streamed
+	QVariantMap fields;
+	for (auto it = eventPoint.fields.cbegin(); it != eventPoint.fields.cend(); it++)
+	{
+		if (it.value().userType() >= QMetaType::User)
+		{
+			continue;
+		}
+		fields.insert(it.key(), it.value());
+	}
+	QByteArray byteFields;
+	QDataStream stream(&byteFields, QIODevice::WriteOnly);
+	stream << fields;
+	QSqlQuery& query = m_writeHistoryEvent;
+	query.bindValue(0, static_cast<qlonglong>(eventPoint.timestamp.ticks()));
+	query.bindValue(1, eventPoint.strSourceNodeId);
+	query.bindValue(2, eventPoint.strEventType);
+	query.bindValue(3, eventPoint.severity);
+	query.bindValue(4, byteFields);
+	if (!query.exec())
+	{
+		logOut << QUaLog({
+			QObject::tr("Could not insert new row in QUaEvents table in %1 database. Sql : %2.")
+				.arg(m_strSqliteDbName)
+				.arg(query.lastError().text()),
+			QUaLogLevel::Error,
+			QUaLogCategory::History
+		});
+		return false;
+	}
+	return true;
+}
+
+QVector<QUaHistoryEventPoint> QUaSqliteHistorizer::readHistoryEvents(
+	const QUaDateTime& timeStart,
+	const QUaDateTime& timeEnd,
+	const QUaHistoryEventFilter& filter,
+	const quint64& numEventsToRead,
+	QQueue<QUaLog>& logOut
+)
+{
+	auto events = QVector<QUaHistoryEventPoint>();
+	// get database handle
+	QSqlDatabase db;
+	if (!this->getOpenedDatabase(db, logOut))
+	{
+		return events;
+	}
+	if (!m_eventTableExists && !this->createEventTable(db, logOut))
+	{
+		return events;
+	}
+	// statement depends on the filter members in use, so sqlite can pick the index
+	const bool hasEnd      = timeEnd.isValid();
+	const bool hasSource   = !filter.strSourceNodeId.isEmpty();
+	const bool hasType     = !filter.strEventType.isEmpty();
+	const bool hasSeverity = filter.minSeverity > 0;
+	int shape = (hasEnd ? 1 : 0) | (hasSource ? 2 : 0) | (hasType ? 4 : 0) | (hasSeverity ? 8 : 0);
+	if (!m_readHistoryEvents.contains(shape))
+	{
+		QString strStmt = 
+			"SELECT "
+				"e.Time, e.SourceNode, e.EventType, e.Severity, e.Fields "
+			"FROM "
+				"QUaEvents e "
+			"WHERE "
+				"e.Time >= :TimeStart ";
+		strStmt += hasEnd      ? "AND e.Time <= :TimeEnd "         : "";
+		strStmt += hasSource   ? "AND e.SourceNode = :SourceNode " : "";
+		strStmt += hasType     ? "AND e.EventType = :EventType "   : "";
+		strStmt += hasSeverity ? "AND e.Severity >= :Severity "    : "";
+		strStmt += 
+			"ORDER BY "
+				"e.Time ASC "
+			"LIMIT "
+				":Limit;";
+		QSqlQuery query(db);
+		if (!this->prepareStmt(query, strStmt, logOut))
+		{
+			return events;
+		}
+		m_readHistoryEvents[shape] = query;
+	}
+	QSqlQuery& query = m_readHistoryEvents[shape];
+	query.bindValue(":TimeStart", static_cast<qlonglong>(timeStart.ticks()));
+	if (hasEnd)
+	{
+		query.bindValue(":TimeEnd", static_cast<qlonglong>(timeEnd.ticks()));
+	}
+	if (hasSource)
+	{
+		query.bindValue(":SourceNode", filter.strSourceNodeId);
+	}
+	if (hasType)
+	{
+		query.bindValue(":EventType", filter.strEventType);
+	}
+	if (hasSeverity)
+	{
+		query.bindValue(":Severity", filter.minSeverity);
+	}
+	// NOTE : negative limit means no limit in sqlite
+	query.bindValue(":Limit", numEventsToRead > 0 ? static_cast<qint64>(numEventsToRead) : -1);
+	if (!query.exec())
+	{
+		logOut << QUaLog({
+			QObject::tr("Error querying QUaEvents table in %1 database. Sql : %2.")
+				.arg(m_strSqliteDbName)
+				.arg(query.lastError().text()),
+			QUaLogLevel::Error,
+			QUaLogCategory::History
+			});
+		return events;
+	}
+	while (query.next())
+	{
+		QUaHistoryEventPoint eventPoint;
+		eventPoint.timestamp       = QUaDateTime(static_cast<UA_DateTime>(query.value(0).toLongLong()));
+		eventPoint.strSourceNodeId = query.value(1).toString();
+		eventPoint.strEventType    = query.value(2).toString();
+		eventPoint.severity        = static_cast<quint16>(query.value(3).toUInt());
+		QByteArray byteFields = query.value(4).toByteArray();
+		QDataStream stream(&byteFields, QIODevice::ReadOnly);
+		stream >> eventPoint.fields;
+		events << eventPoint;
+	}
+	return events;
+}
+
+bool QUaSqliteHistorizer::createEventTable(
+	QSqlDatabase& db,
+	QQueue<QUaLog>& logOut)
+{
+	Q_ASSERT(db.isValid() && db.isOpen());
+	QSqlQuery query(db);
+	QStringList listStmts = QStringList()
+		<< "CREATE TABLE IF NOT EXISTS QUaEvents"
+		   "("
+				"[QUaEvents] INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL,"
+				"[Time] INTEGER NOT NULL,"
+				"[SourceNode] TEXT NOT NULL,"
+				"[EventType] TEXT NOT NULL,"
+				"[Severity] INTEGER NOT NULL,"
+				"[Fields] BLOB NOT NULL"
+		   ");"
+		// indexes so queries by time, source or type do not scan the table
+		<< "CREATE INDEX IF NOT EXISTS QUaEvents_Time ON QUaEvents(Time);"
+		<< "CREATE INDEX IF NOT EXISTS QUaEvents_SourceNode_Time ON QUaEvents(SourceNode, Time);"
+		<< "CREATE INDEX IF NOT EXISTS QUaEvents_EventType_Time ON QUaEvents(EventType, Time);";
+	for (const auto& strStmt : listStmts)
+	{
+		if (!query.exec(strStmt))
+		{
+			logOut << QUaLog({
+				QObject::tr("Could not create QUaEvents table or index in %1 database. Sql : %2.")
+					.arg(m_strSqliteDbName)
+					.arg(query.lastError().text()),
+				QUaLogLevel::Error,
+				QUaLogCategory::History
+				});
+			return false;
+		}
+	}
+	// prepared statement for insert
+	if (!this->prepareStmt(query,
+		"INSERT INTO QUaEvents (Time, SourceNode, EventType, Severity, Fields) "
+		"VALUES (:Time, :SourceNode, :EventType, :Severity, :Fields);", logOut))
+	{
+		return false;
+	}
+	m_writeHistoryEvent = query;
+	m_eventTableExists = true;
+	return true;
+}
+
 bool QUaSqliteHistorizer::getOpenedDatabase(
 	QSqlDatabase& db,
 	QQueue<QUaLog>& logOut
@@ -754,7 +961,7 @@ bool QUaSqliteHistorizer::insertNewDataPoint(
 	Q_ASSERT(db.isValid() && db.isOpen());
 	Q_ASSERT(m_prepStmts.contains(strNodeId));
 	QSqlQuery& query = m_prepStmts[strNodeId].writeHistoryData;
-	query.bindValue(0, dataPoint.timestamp.toMSecsSinceEpoch());
+	query.bindValue(0, static_cast<qlonglong>(dataPoint.timestamp.ticks()));
 	query.bindValue(1, dataPoint.value);
 	query.bindValue(2, dataPoint.status);
 	if (!query.exec())
@@ -8,6 +8,8 @@
 #include <QSqlQuery>
 #include <QTimer>
 
+// NOTE : timestamps are stored as OPC UA DateTime ticks (100 nanoseconds since 1601-01-01 UTC),
+//        databases written by older versions (milliseconds since epoch) are not compatible
 class QUaSqliteHistorizer
 {
 public:
@@ -45,19 +47,19 @@ public:
 	// remove an existing node's data points within a range, return true on success
 	bool removeHistoryData(
 		const QString& strNodeId,
-		const QDateTime& timeStart,
-		const QDateTime& timeEnd,
+		const QUaDateTime& timeStart,
+		const QUaDateTime& timeEnd,
 		QQueue<QUaLog>& logOut
 	);
 	// required API for QUaServer::setHistorizer
 	// return the timestamp of the first sample available for the given node
-	QDateTime firstTimestamp(
+	QUaDateTime firstTimestamp(
 		const QString& strNodeId,
 		QQueue<QUaLog>& logOut
 	);
 	// required API for QUaServer::setHistorizer
 	// return the timestamp of the latest sample available for the given node
-	QDateTime lastTimestamp(
+	QUaDateTime lastTimestamp(
 		const QString& strNodeId,
 		QQueue<QUaLog>& logOut
 	);
@@ -65,14 +67,14 @@ public:
 	// return true if given timestamp is available for the given node
 	bool hasTimestamp(
 		const QString& strNodeId,
-		const QDateTime& timestamp,
+		const QUaDateTime& timestamp,
 		QQueue<QUaLog>& logOut
 	);
 	// required API for QUaServer::setHistorizer
 	// return a timestamp matching the criteria for the given node
-	QDateTime findTimestamp(
+	QUaDateTime findTimestamp(
 		const QString& strNodeId,
-		const QDateTime& timestamp,
+		const QUaDateTime& timestamp,
 		const QUaHistoryBackend::TimeMatch& match,
 		QQueue<QUaLog>& logOut
 	);
@@ -80,19 +82,35 @@ public:
 	// return the number for data points within a time range for the given node
 	quint64 numDataPointsInRange(
 		const QString& strNodeId,
-		const QDateTime& timeStart,
-		const QDateTime& timeEnd,
+		const QUaDateTime& timeStart,
+		const QUaDateTime& timeEnd,
 		QQueue<QUaLog>& logOut
 	);
 	// required API for QUaServer::setHistorizer
 	// return the numPointsToRead data points for the given node form the given start time
 	QVector<QUaHistoryDataPoint> readHistoryData(
 		const QString& strNodeId,
-		const QDateTime& timeStart,
+		const QUaDateTime& timeStart,
 		const quint64& numPointsToRead,
 		QQueue<QUaLog>& logOut
 	);
 
+	// optional events API for QUaServer::setEventHistorizing
+	// write event to backend, return true on success
+	bool writeHistoryEventPoint(
+		const QUaHistoryEventPoint& eventPoint,
+		QQueue<QUaLog>& logOut
+	);
+	// optional events API for QUaServer::setEventHistorizing
+	// return the events matching the filter within the time range, ordered by time
+	QVector<QUaHistoryEventPoint> readHistoryEvents(
+		const QUaDateTime& timeStart,
+		const QUaDateTime& timeEnd,
+		const QUaHistoryEventFilter& filter,
+		const quint64& numEventsToRead,
+		QQueue<QUaLog>& logOut
+	);
+
 private:
 	QString m_strSqliteDbName;
 	QTimer m_timerTransaction;
@@ -142,6 +160,15 @@ private:
 		QSqlQuery readHistoryData;
 	};
 	QHash<QString, PreparedStatements> m_prepStmts;
+	// events table, indexed by time, by source and time and by type and time
+	bool m_eventTableExists;
+	QSqlQuery m_writeHistoryEvent;
+	// read statements cached per filter shape (which filter members are used)
+	QHash<int, QSqlQuery> m_readHistoryEvents;
+	bool createEventTable(
+		QSqlDatabase& db,
+		QQueue<QUaLog>& logOut
+	);
 	// prepare statement to insert history data points
 	bool prepareAllStmts(
 		QSqlDatabase& db,
@@ -0,0 +1,52 @@
+#include "quaalarmconditionevent.h"
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
+QUaAlarmConditionEvent::QUaAlarmConditionEvent(QUaServer *server)
+	: QUaBaseEvent(server)
+{
+	m_conditionName  = this->findChild<QUaProperty*>("conditionName");
+	m_activeState    = this->findChild<QUaProperty*>("activeState");
+	m_ackedState     = this->findChild<QUaProperty*>("ackedState");
+	m_confirmedState = this->findChild<QUaProperty*>("confirmedState");
+	m_retain         = this->findChild<QUaProperty*>("retain");
+	m_limitState     = this->findChild<QUaProperty*>("limitState");
+	m_inputValue     = this->findChild<QUaProperty*>("inputValue");
+}
+
+QUaProperty * QUaAlarmConditionEvent::conditionName()
+{
+	return m_conditionName;
+}
+
+QUaProperty * QUaAlarmConditionEvent::activeState()
+{
+	return m_activeState;
+}
+
+QUaProperty * QUaAlarmConditionEvent::ackedState()
+{
+	return m_ackedState;
+}
+
+QUaProperty * QUaAlarmConditionEvent::confirmedState()
+{
+	return m_confirmedState;
+}
+
+QUaProperty * QUaAlarmConditionEvent::retain()
+{
+	return m_retain;
+}
+
+QUaProperty * QUaAlarmConditionEvent::limitState()
+{
+	return m_limitState;
+}
+
+QUaProperty * QUaAlarmConditionEvent::inputValue()
+{
+	return m_inputValue;
+}
+
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
@@ -0,0 +1,59 @@
+#ifndef QUAALARMCONDITIONEVENT_H
+#define QUAALARMCONDITIONEVENT_H
+
+#include <QUaBaseEvent>
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
+/*
+Part 9 - 5.8.2 AlarmConditionType (subset)
+Event triggered by QUaLimitAlarms on every state transition of a limit alarm.
+The two-state variables of the standard type (ActiveState, AckedState, ConfirmedState) 
+are flattened to their boolean Id, and the ExclusiveLimitStateMachine to its state name.
+*/
+
+class QUaAlarmConditionEvent : public QUaBaseEvent
+{
+    Q_OBJECT
+
+	// String : name of the condition, unique within its QUaLimitAlarms
+	Q_PROPERTY(QUaProperty * conditionName  READ conditionName )
+	// Boolean : input is beyond one of the limits
+	Q_PROPERTY(QUaProperty * activeState    READ activeState   )
+	// Boolean : alarm was acknowledged since it became active
+	Q_PROPERTY(QUaProperty * ackedState     READ ackedState    )
+	// Boolean : alarm was confirmed since it was acknowledged
+	Q_PROPERTY(QUaProperty * confirmedState READ confirmedState)
+	// Boolean : condition is of interest to clients (active, unacknowledged or unconfirmed)
+	Q_PROPERTY(QUaProperty * retain         READ retain        )
+	// String : HighHigh, High, Low, LowLow or empty if normal
+	Q_PROPERTY(QUaProperty * limitState     READ limitState    )
+	// Double : input value that caused the transition
+	Q_PROPERTY(QUaProperty * inputValue     READ inputValue    )
+
+public:
+	Q_INVOKABLE explicit QUaAlarmConditionEvent(QUaServer *server);
+
+	QUaProperty * conditionName ();
+	QUaProperty * activeState   ();
+	QUaProperty * ackedState    ();
+	QUaProperty * confirmedState();
+	QUaProperty * retain        ();
+	QUaProperty * limitState    ();
+	QUaProperty * inputValue    ();
+
+private:
+	// cached on construction
+	QUaProperty * m_conditionName;
+	QUaProperty * m_activeState;
+	QUaProperty * m_ackedState;
+	QUaProperty * m_confirmedState;
+	QUaProperty * m_retain;
+	QUaProperty * m_limitState;
+	QUaProperty * m_inputValue;
+
+};
+
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
+#endif // QUAALARMCONDITIONEVENT_H
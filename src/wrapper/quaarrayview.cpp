@@ -0,0 +1,69 @@
+#include "quaarrayview.h"
+
+QUaByteArrayView::QUaByteArrayView()
+	: QUaArrayView<char>()
+{
+}
+
+QUaByteArrayView::QUaByteArrayView(const char * data, const int & size)
+	: QUaArrayView<char>(data, size)
+{
+}
+
+QUaByteArrayView QUaByteArrayView::fromUaVariant(const UA_Variant & uaVariant)
+{
+	if (!UA_Variant_hasScalarType(&uaVariant, &UA_TYPES[UA_TYPES_BYTESTRING]))
+	{
+		return QUaByteArrayView();
+	}
+	auto byteString = static_cast<const UA_ByteString*>(uaVariant.data);
+	return QUaByteArrayView(reinterpret_cast<const char*>(byteString->data), static_cast<int>(byteString->length));
+}
+
+QByteArray QUaByteArrayView::toRawByteArray() const
+{
+	return QByteArray::fromRawData(m_data, m_size);
+}
+
+QByteArray QUaByteArrayView::toByteArray() const
+{
+	return QByteArray(m_data, m_size);
+}
+
+QUaByteArrayBuffer::QUaByteArrayBuffer(const int & size/* = 0*/)
+	: m_variant(UA_Variant_new(), [](UA_Variant * variant) { UA_Variant_delete(variant); })
+{
+	UA_ByteString * byteString = UA_ByteString_new();
+	if (size > 0)
+	{
+		auto st = UA_ByteString_allocBuffer(byteString, static_cast<size_t>(size));
+		Q_ASSERT(st == UA_STATUSCODE_GOOD);
+		Q_UNUSED(st);
+	}
+	UA_Variant_setScalar(m_variant.get(), byteString, &UA_TYPES[UA_TYPES_BYTESTRING]);
+}
+
+char * QUaByteArrayBuffer::data()
+{
+	if (!m_variant->data)
+	{
+		return nullptr;
+	}
+	return reinterpret_cast<char*>(static_cast<UA_ByteString*>(m_variant->data)->data);
+}
+
+int QUaByteArrayBuffer::size() const
+{
+	if (!m_variant->data)
+	{
+		return 0;
+	}
+	return static_cast<int>(static_cast<UA_ByteString*>(m_variant->data)->length);
+}
+
+UA_Variant QUaByteArrayBuffer::release()
+{
+	UA_Variant variant = *m_variant;
+	UA_Variant_init(m_variant.get());
+	return variant;
+}
@@ -0,0 +1,239 @@
+#ifndef QUAARRAYVIEW_H
+#define QUAARRAYVIEW_H
+
+#include <memory>
+
+#include <QByteArray>
+#include <QVector>
+
+#include <QUaTypesConverter>
+
+// Non-owning view onto a numeric array method argument (QUaBaseObject::addMethod)
+// NOTE : points to the request data, only valid while the method callback runs
+template<typename T>
+class QUaArrayView
+{
+public:
+	QUaArrayView();
+	QUaArrayView(const T * data, const int &size);
+
+	// empty if variant is not an array of T
+	static QUaArrayView<T> fromUaVariant(const UA_Variant &uaVariant);
+
+	const T * data   () const;
+	int       size   () const;
+	bool      isEmpty() const;
+	const T * begin  () const;
+	const T * end    () const;
+	const T & operator[](const int &index) const;
+	// copies the data
+	QVector<T> toVector() const;
+
+protected:
+	const T * m_data;
+	int       m_size;
+};
+
+// Non-owning view onto a ByteString method argument
+class QUaByteArrayView : public QUaArrayView<char>
+{
+public:
+	QUaByteArrayView();
+	QUaByteArrayView(const char * data, const int &size);
+
+	// empty if variant is not a ByteString scalar
+	static QUaByteArrayView fromUaVariant(const UA_Variant &uaVariant);
+
+	// QByteArray sharing the data (QByteArray::fromRawData), valid as long as the view
+	QByteArray toRawByteArray() const;
+	// copies the data
+	QByteArray toByteArray() const;
+};
+
+// Numeric array allocated with the open62541 allocator, returned by a method
+// callback the buffer is adopted by the Call response without copy
+// NOTE : copies share the same buffer
+template<typename T>
+class QUaArrayBuffer
+{
+public:
+	explicit QUaArrayBuffer(const int &size = 0);
+
+	T * data();
+	int size() const;
+
+	// moves buffer into variant, buffer is empty afterwards
+	UA_Variant release();
+
+private:
+	std::shared_ptr<UA_Variant> m_variant;
+};
+
+// ByteString allocated with the open62541 allocator, returned by a method
+// callback the buffer is adopted by the Call response without copy
+// NOTE : copies share the same buffer
+class QUaByteArrayBuffer
+{
+public:
+	explicit QUaByteArrayBuffer(const int &size = 0);
+
+	char * data();
+	int    size() const;
+
+	// moves buffer into variant, buffer is empty afterwards
+	UA_Variant release();
+
+private:
+	std::shared_ptr<UA_Variant> m_variant;
+};
+
+// method traits helpers
+
+template <typename T>
+struct view_traits : std::false_type
+{};
+
+template <typename T>
+struct view_traits<QUaArrayView<T>> : std::true_type
+{
+	static UA_NodeId uaTypeNodeId()
+	{
+		return QUaTypesConverter::uaTypeNodeIdFromCpp<T>();
+	}
+	static const UA_Int32 valueRank = UA_VALUERANK_ONE_DIMENSION;
+};
+
+template <>
+struct view_traits<QUaByteArrayView> : std::true_type
+{
+	static UA_NodeId uaTypeNodeId()
+	{
+		return UA_NODEID_NUMERIC(0, UA_NS0ID_BYTESTRING);
+	}
+	static const UA_Int32 valueRank = UA_VALUERANK_SCALAR;
+};
+
+template <typename T>
+struct buffer_traits : std::false_type
+{};
+
+template <typename T>
+struct buffer_traits<QUaArrayBuffer<T>> : std::true_type
+{
+	static UA_NodeId uaTypeNodeId()
+	{
+		return QUaTypesConverter::uaTypeNodeIdFromCpp<T>();
+	}
+	static const UA_Int32 valueRank = UA_VALUERANK_ONE_DIMENSION;
+};
+
+template <>
+struct buffer_traits<QUaByteArrayBuffer> : std::true_type
+{
+	static UA_NodeId uaTypeNodeId()
+	{
+		return UA_NODEID_NUMERIC(0, UA_NS0ID_BYTESTRING);
+	}
+	static const UA_Int32 valueRank = UA_VALUERANK_SCALAR;
+};
+
+template<typename T>
+inline QUaArrayView<T>::QUaArrayView()
+	: m_data(nullptr), m_size(0)
+{
+}
+
+template<typename T>
+inline QUaArrayView<T>::QUaArrayView(const T * data, const int & size)
+	: m_data(size > 0 ? data : nullptr), m_size(size > 0 ? size : 0)
+{
+}
+
+template<typename T>
+inline QUaArrayView<T> QUaArrayView<T>::fromUaVariant(const UA_Variant & uaVariant)
+{
+	const UA_DataType * type = QUaTypesConverter::uaTypeFromQType(QUaTypesConverter::qtTypeFromCpp<T>());
+	// NOTE : type is null for unsupported T, uaVariant.type for empty variants
+	if (!type || UA_Variant_isScalar(&uaVariant) || uaVariant.type != type || type->memSize != sizeof(T))
+	{
+		return QUaArrayView<T>();
+	}
+	return QUaArrayView<T>(static_cast<const T*>(uaVariant.data), static_cast<int>(uaVariant.arrayLength));
+}
+
+template<typename T>
+inline const T * QUaArrayView<T>::data() const
+{
+	return m_data;
+}
+
+template<typename T>
+inline int QUaArrayView<T>::size() const
+{
+	return m_size;
+}
+
+template<typename T>
+inline bool QUaArrayView<T>::isEmpty() const
+{
+	return m_size == 0;
+}
+
+template<typename T>
+inline const T * QUaArrayView<T>::begin() const
+{
+	return m_data;
+}
+
+template<typename T>
+inline const T * QUaArrayView<T>::end() const
+{
+	return m_data + m_size;
+}
+
+template<typename T>
+inline const T & QUaArrayView<T>::operator[](const int & index) const
+{
+	Q_ASSERT(index >= 0 && index < m_size);
+	return m_data[index];
+}
+
+template<typename T>
+inline QVector<T> QUaArrayView<T>::toVector() const
+{
+	QVector<T> vector(m_size);
+	std::copy(this->begin(), this->end(), vector.begin());
+	return vector;
+}
+
+template<typename T>
+inline QUaArrayBuffer<T>::QUaArrayBuffer(const int & size/* = 0*/)
+	: m_variant(UA_Variant_new(), [](UA_Variant * variant) { UA_Variant_delete(variant); })
+{
+	const UA_DataType * type = QUaTypesConverter::uaTypeFromQType(QUaTypesConverter::qtTypeFromCpp<T>());
+	Q_ASSERT_X(type && type->memSize == sizeof(T), "QUaArrayBuffer", "Unsupported type.");
+	size_t length = static_cast<size_t>(qMax(0, size));
+	UA_Variant_setArray(m_variant.get(), UA_Array_new(length, type), length, type);
+}
+
+template<typename T>
+inline T * QUaArrayBuffer<T>::data()
+{
+	return m_variant->arrayLength > 0 ? static_cast<T*>(m_variant->data) : nullptr;
+}
+
+template<typename T>
+inline int QUaArrayBuffer<T>::size() const
+{
+	return static_cast<int>(m_variant->arrayLength);
+}
+
+template<typename T>
+inline UA_Variant QUaArrayBuffer<T>::release()
+{
+	UA_Variant variant = *m_variant;
+	UA_Variant_init(m_variant.get());
+	return variant;
+}
+
+#endif // QUAARRAYVIEW_H
@@ -20,6 +20,16 @@ QUaBaseEvent::QUaBaseEvent(QUaServer *server)
 {
 	// copy temp originator nodeId, this was user can trigger the event in its derived class constructor
 	m_nodeIdOriginator = *server->m_newEventOriginatorNodeId;
+	// resolve field children once, they are already created by QUaNode constructor
+	m_eventId     = this->findChild<QUaProperty*>("EventId");
+	m_eventType   = this->findChild<QUaProperty*>("EventType");
+	m_sourceNode  = this->findChild<QUaProperty*>("SourceNode");
+	m_sourceName  = this->findChild<QUaProperty*>("SourceName");
+	m_time        = this->findChild<QUaProperty*>("Time");
+	m_receiveTime = this->findChild<QUaProperty*>("ReceiveTime");
+	m_localTime   = this->findChild<QUaProperty*>("LocalTime");
+	m_message     = this->findChild<QUaProperty*>("Message");
+	m_severity    = this->findChild<QUaProperty*>("Severity");
 	this->setTime(QDateTime::currentDateTimeUtc());
 
 	// NOTE : removed because is optional and open62541 now does not add it
@@ -110,10 +120,27 @@ void QUaBaseEvent::setSeverity(const quint16 & intSeverity)
 	this->getSeverity()->setValue(intSeverity);
 }
 
+void QUaBaseEvent::setFields(const QString   & strSourceName, 
+	                         const QString   & strMessage, 
+	                         const quint16   & intSeverity, 
+	                         const QDateTime & dateTime/* = QDateTime()*/)
+{
+	m_sourceName->setValue(strSourceName);
+	m_message->setValue(strMessage, METATYPE_LOCALIZEDTEXT);
+	m_severity->setValue(intSeverity);
+	m_time->setValue(dateTime.isValid() ? dateTime.toUTC() : QDateTime::currentDateTimeUtc());
+}
+
 void QUaBaseEvent::trigger()
 {
 	Q_ASSERT(!UA_NodeId_isNull(&m_nodeId));
 	Q_ASSERT(!UA_NodeId_isNull(&m_nodeIdOriginator));
+	// drop if over the rate limit of its source or type
+	if (m_qUaServer->eventRateLimited() &&
+		!m_qUaServer->admitEvent(QUaNode::getNodeContext(m_nodeIdOriginator, m_qUaServer), *this->metaObject(), this->severity()))
+	{
+		return;
+	}
 	// NOTE : event life-time attached to C++ instance life-time
 	auto st = UA_Server_triggerEvent(
 		m_qUaServer->m_server,
@@ -124,51 +151,57 @@ void QUaBaseEvent::trigger()
 	);
 	Q_ASSERT(st == UA_STATUSCODE_GOOD);
 	Q_UNUSED(st);
+#ifdef UA_ENABLE_HISTORIZING
+	if (m_qUaServer->m_eventHistorizing && st == UA_STATUSCODE_GOOD)
+	{
+		m_qUaServer->historizeEvent(this, m_nodeIdOriginator);
+	}
+#endif // UA_ENABLE_HISTORIZING
 }
 
 QUaProperty * QUaBaseEvent::getEventId() 
 {
-	return this->findChild<QUaProperty*>("EventId");
+	return m_eventId;
 }
 
 QUaProperty * QUaBaseEvent::getEventType()
 {
-	return this->findChild<QUaProperty*>("EventType");
+	return m_eventType;
 }
 
 QUaProperty * QUaBaseEvent::getSourceNode()
 {
-	return this->findChild<QUaProperty*>("SourceNode");
+	return m_sourceNode;
 }
 
 QUaProperty * QUaBaseEvent::getSourceName()
 {
-	return this->findChild<QUaProperty*>("SourceName");
+	return m_sourceName;
 }
 
 QUaProperty * QUaBaseEvent::getTime()
 {
-	return this->findChild<QUaProperty*>("Time");
+	return m_time;
 }
 
 QUaProperty * QUaBaseEvent::getReceiveTime()
 {
-	return this->findChild<QUaProperty*>("ReceiveTime");
+	return m_receiveTime;
 }
 
 QUaProperty * QUaBaseEvent::getLocalTime()
 {
-	return this->findChild<QUaProperty*>("LocalTime");
+	return m_localTime;
 }
 
 QUaProperty * QUaBaseEvent::getMessage()
 {
-	return this->findChild<QUaProperty*>("Message");
+	return m_message;
 }
 
 QUaProperty * QUaBaseEvent::getSeverity()
 {
-	return this->findChild<QUaProperty*>("Severity");
+	return m_severity;
 }
 
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
\ No newline at end of file
@@ -75,6 +75,12 @@ public:
 
 	// Custom Event API
 
+	// Sets the common fields at once before calling trigger(), invalid time means current time
+	void setFields(const QString   &strSourceName, 
+		           const QString   &strMessage, 
+		           const quint16   &intSeverity, 
+		           const QDateTime &dateTime = QDateTime());
+
 	// Triggers the event and updates eventId, sourceNode, eventType and receiveTime
 	void trigger();
 
@@ -108,6 +114,17 @@ private:
 	// Used to trigger the event
 	UA_NodeId m_nodeIdOriginator;
 
+	// field children, resolved once in constructor
+	QUaProperty * m_eventId;
+	QUaProperty * m_eventType;
+	QUaProperty * m_sourceNode;
+	QUaProperty * m_sourceName;
+	QUaProperty * m_time;
+	QUaProperty * m_receiveTime;
+	QUaProperty * m_localTime;
+	QUaProperty * m_message;
+	QUaProperty * m_severity;
+
 };
 
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
@@ -2,6 +2,8 @@
 
 #include <QUaServer>
 
+#include <QElapsedTimer>
+
 // [STATIC]
 UA_StatusCode QUaBaseObject::methodCallback(UA_Server        * server,
 	                                        const UA_NodeId  * sessionId, 
@@ -16,12 +18,9 @@ UA_StatusCode QUaBaseObject::methodCallback(UA_Server        * server,
 	                                        UA_Variant       * output)
 {
 	Q_UNUSED(server        );
-	Q_UNUSED(sessionId     );
 	Q_UNUSED(sessionContext);
 	Q_UNUSED(objectId      );
 	Q_UNUSED(objectContext );
-	Q_UNUSED(inputSize     );
-	Q_UNUSED(outputSize    );
 	// get node from context object
 #ifdef QT_DEBUG 
 	auto obj = dynamic_cast<QUaBaseObject*>(static_cast<QObject*>(methodContext));
@@ -33,9 +32,22 @@ UA_StatusCode QUaBaseObject::methodCallback(UA_Server        * server,
 	{
 		return (UA_StatusCode)UA_STATUSCODE_BADUNEXPECTEDERROR;
 	}
-	Q_ASSERT(obj->m_hashMethods.contains(*methodId));
-	// get method from node callbacks map and call it
-	return obj->m_hashMethods[*methodId](input, output);
+	QUaSession * session = obj->m_qUaServer->sessionById(sessionId);
+	if (!session)
+	{
+		return obj->callMethod(session, *methodId, input, output);
+	}
+	// admission control
+	if (!obj->m_qUaServer->admitRequest(session, QUaSession::Service::Call))
+	{
+		return (UA_StatusCode)UA_STATUSCODE_BADTOOMANYOPERATIONS;
+	}
+	// account client call
+	QElapsedTimer timer;
+	timer.start();
+	UA_StatusCode st = obj->callMethod(session, *methodId, input, output);
+	session->addCall(timer.nsecsElapsed(), input, inputSize, output, outputSize, st);
+	return st;
 }
 
 QUaBaseObject::QUaBaseObject(QUaServer *server)
@@ -44,6 +56,46 @@ QUaBaseObject::QUaBaseObject(QUaServer *server)
 
 }
 
+UA_StatusCode QUaBaseObject::callMethod(QUaSession * session, const UA_NodeId & methodId, const UA_Variant * input, UA_Variant * output)
+{
+	// get method from node callbacks map and call it
+	auto iter = m_hashMethods.find(methodId);
+	if (iter != m_hashMethods.end())
+	{
+		return iter.value()(input, output);
+	}
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	return this->callMethodAsync(session, methodId, input, output);
+#else
+	Q_UNUSED(session);
+	Q_ASSERT_X(false, "QUaBaseObject::callMethod", "Method callback not found.");
+	return (UA_StatusCode)UA_STATUSCODE_BADMETHODINVALID;
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+}
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+UA_StatusCode QUaBaseObject::callMethodAsync(QUaSession * session, const UA_NodeId & methodId, const UA_Variant * input, UA_Variant * output)
+{
+	Q_ASSERT(m_hashAsyncMethods.contains(methodId));
+	// running calls are limited and cancelled per session, internal calls have none
+	if (!session)
+	{
+		return (UA_StatusCode)UA_STATUSCODE_BADSESSIONIDINVALID;
+	}
+	if (session->m_pendingCalls >= m_qUaServer->m_maxPendingCallsPerSession)
+	{
+		return (UA_StatusCode)UA_STATUSCODE_BADTOOMANYOPERATIONS;
+	}
+	// start call, completion is reported by QUaMethodCompletedEvent
+	QUaPendingCall call = m_hashAsyncMethods[methodId](input);
+	call.object  = this;
+	call.session = session;
+	quint32 handle = m_qUaServer->addPendingCall(call);
+	// handle is the only output argument
+	return UA_Variant_setScalarCopy(output, &handle, &UA_TYPES[UA_TYPES_UINT32]);
+}
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
 quint8 QUaBaseObject::eventNotifier() const
 {
 	UA_Byte outByte;
@@ -2,6 +2,10 @@
 #define QUABASEOBJECT_H
 
 #include <QUaNode>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QPointer>
+#include <QDateTime>
 
 /*
 typedef struct {                          // UA_ObjectTypeAttributes_default
@@ -36,6 +40,33 @@ This ObjectType is the base ObjectType and all other ObjectTypes shall either
 directly or indirectly inherit from it.
 */
 
+class QUaSession;
+class QUaBaseObject;
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+// Asynchronous method call in progress (see QUaBaseObject::addMethodAsync)
+struct QUaPendingCall
+{
+	QPointer<QUaBaseObject>                 object;
+	QString                                 strMethodName;
+	QUaSession                            * session;
+	std::function<UA_StatusCode(QVariant&)> result;
+	std::function<void()>                   cancel;
+	// emits finished when the future finishes, deleted with the call
+	QFutureWatcherBase                    * watcher;
+	qint64                                  deadline; // [ms] since epoch
+
+	template<typename T>
+	static QUaPendingCall fromFuture(const QFuture<T> &future, const quint32 &timeoutMs);
+
+private:
+	template<typename T>
+	static UA_StatusCode futureResult(std::false_type, const QFuture<T> &future, QVariant &value);
+	template<typename T>
+	static UA_StatusCode futureResult(std::true_type, const QFuture<T> &future, QVariant &value);
+};
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
 class QUaBaseObject : public QUaNode
 {
     Q_OBJECT
@@ -71,6 +102,21 @@ public:
 
 	template<typename M>
 	void addMethod(const QString &strMethodName, const M &methodCallback, const QString & strNodeId = "");
+	// replaces the callback of a method added with QUaServer::addTypeMethod for this instance only
+	// NOTE : callback has the same arguments as the type method without the instance
+	template<typename M>
+	void overrideMethod(const QString &strMethodName, const M &methodCallback);
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	// methodCallback returns a QFuture<T>, the server keeps iterating while it runs
+	// NOTE : open62541 v1.0 cannot defer the Call response, so the Call starts the method and
+	//        returns at once with a UInt32 CallHandle as its only output argument. When the future
+	//        finishes, or after timeoutMs (then it is cancelled), a QUaMethodCompletedEvent with
+	//        the handle, status and result is triggered from this object.
+	//        Running calls per session are limited by the server (maxPendingCallsPerSession)
+	//        Arguments cannot be views (QUaArrayView, QUaByteArrayView), the request is freed on return
+	template<typename M>
+	void addMethodAsync(const QString &strMethodName, const M &methodCallback, const quint32 &timeoutMs = 10000, const QString & strNodeId = "");
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
 	// Events API
@@ -105,7 +151,52 @@ private:
 		                                UA_Variant       *output);
 
 	QHash< UA_NodeId, std::function<UA_StatusCode(const UA_Variant*, UA_Variant*)>> m_hashMethods;
+	UA_StatusCode callMethod     (QUaSession *session, const UA_NodeId &methodId, const UA_Variant *input, UA_Variant *output);
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	QHash< UA_NodeId, std::function<QUaPendingCall(const UA_Variant*)>> m_hashAsyncMethods;
+
+	UA_StatusCode callMethodAsync(QUaSession *session, const UA_NodeId &methodId, const UA_Variant *input, UA_Variant *output);
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 };
 
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+template<typename T>
+inline QUaPendingCall QUaPendingCall::fromFuture(const QFuture<T> & future, const quint32 & timeoutMs)
+{
+	QUaPendingCall call;
+	call.session = nullptr;
+	call.result = [future](QVariant & value) {
+		return QUaPendingCall::futureResult<T>(std::is_void<T>(), future, value);
+	};
+	call.cancel = [future]() mutable {
+		future.cancel();
+	};
+	// NOTE : finished is posted to the event loop, even if the future is already finished
+	auto watcher = new QFutureWatcher<T>();
+	watcher->setFuture(future);
+	call.watcher  = watcher;
+	call.deadline = QDateTime::currentMSecsSinceEpoch() + timeoutMs;
+	return call;
+}
+
+template<typename T>
+inline UA_StatusCode QUaPendingCall::futureResult(std::false_type, const QFuture<T> & future, QVariant & value)
+{
+	if (future.isCanceled() || future.resultCount() == 0)
+	{
+		return UA_STATUSCODE_BADINTERNALERROR;
+	}
+	value = QVariant::fromValue(future.result());
+	return UA_STATUSCODE_GOOD;
+}
+
+template<typename T>
+inline UA_StatusCode QUaPendingCall::futureResult(std::true_type, const QFuture<T> & future, QVariant & value)
+{
+	Q_UNUSED(value);
+	return future.isCanceled() ? UA_STATUSCODE_BADINTERNALERROR : UA_STATUSCODE_GOOD;
+}
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
 #endif // QUABASEOBJECT_H
 
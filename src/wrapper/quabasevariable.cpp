@@ -3,6 +3,8 @@
 #include <QUaServer>
 #include <QUaBaseDataVariable>
 
+#include <QElapsedTimer>
+
 QMetaEnum QUaDataType::m_metaEnum = QMetaEnum::fromType<QUa::Type>();
 
 QUaDataType::QUaDataType()
@@ -47,6 +49,79 @@ void QUaDataType::operator=(const QString& strType)
 	*this = QUaDataType(strType.toUtf8());
 }
 
+bool QUaChangeFilter::isEnabled() const
+{
+	return filterUnchanged || deadbandType != QUaDeadbandType::None || minInterval > 0;
+}
+
+bool QUaChangeFilter::skipValue(const QVariant & value) const
+{
+	// nothing to compare against yet
+	if (!lastValue.isValid())
+	{
+		return false;
+	}
+	// min interval
+	if (minInterval > 0 && lastTime.isValid() && lastTime.elapsed() < static_cast<qint64>(minInterval))
+	{
+		return true;
+	}
+	// exact change
+	if (filterUnchanged && value == lastValue)
+	{
+		return true;
+	}
+	// deadband
+	if (deadbandType != QUaDeadbandType::None && !this->exceedsDeadband(value, lastValue))
+	{
+		return true;
+	}
+	return false;
+}
+
+bool QUaChangeFilter::exceedsDeadband(const QVariant & value, const QVariant & oldValue) const
+{
+	// arrays, exceeded if any element exceeds
+	if (value.canConvert<QVariantList>() && value.type() != QVariant::String && value.type() != QVariant::ByteArray)
+	{
+		if (!oldValue.canConvert<QVariantList>())
+		{
+			return true;
+		}
+		auto iterNew = value.value<QSequentialIterable>();
+		auto iterOld = oldValue.value<QSequentialIterable>();
+		if (iterNew.size() != iterOld.size())
+		{
+			return true;
+		}
+		for (int i = 0; i < iterNew.size(); i++)
+		{
+			if (this->exceedsDeadband(iterNew.at(i), iterOld.at(i)))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+	// non numeric values always exceed unless equal
+	bool okNew = false, okOld = false;
+	double dblNew = value.toDouble(&okNew);
+	double dblOld = oldValue.toDouble(&okOld);
+	if (!okNew || !okOld)
+	{
+		return value != oldValue;
+	}
+	double diff = qAbs(dblNew - dblOld);
+	if (deadbandType == QUaDeadbandType::Absolute)
+	{
+		return diff > deadbandValue;
+	}
+	Q_ASSERT(deadbandType == QUaDeadbandType::Percent);
+	// relative to EURange if any, else to last value
+	double span = rangeHigh > rangeLow ? rangeHigh - rangeLow : qAbs(dblOld);
+	return diff > (deadbandValue / 100.0) * span;
+}
+
 // [STATIC]
 void QUaBaseVariable::onWrite(UA_Server             *server, 
 		                      const UA_NodeId       *sessionId,
@@ -57,11 +132,9 @@ void QUaBaseVariable::onWrite(UA_Server             *server,
 		                      const UA_DataValue    *data)
 {
 	Q_UNUSED(server);
-	Q_UNUSED(sessionId);
 	Q_UNUSED(sessionContext);
 	Q_UNUSED(nodeId);
 	Q_UNUSED(range);
-	Q_UNUSED(data);
 	// get variable from context
 #ifdef QT_DEBUG 
 	auto var = dynamic_cast<QUaBaseVariable*>(static_cast<QObject*>(nodeContext));
@@ -79,8 +152,21 @@ void QUaBaseVariable::onWrite(UA_Server             *server,
 		var->m_bInternalWrite = false;
 		return;
 	}
+	QElapsedTimer timer;
+	timer.start();
+	// last filtered value no longer valid
+	var->resetChangeFilter();
+	// notify immediately if enabled
+	var->notifyMonitoredItems();
 	// emit value changed
 	emit var->valueChanged(var->value());
+	// account client write
+	QUaSession * session = var->m_qUaServer->sessionById(sessionId);
+	if (session)
+	{
+		session->addRequest(QUaSession::Service::Write, timer.nsecsElapsed(),
+			UA_calcSizeBinary(data, &UA_TYPES[UA_TYPES_DATAVALUE]));
+	}
 }
 
 // [STATIC]
@@ -109,7 +195,14 @@ void QUaBaseVariable::onRead(UA_Server             *server,
 	{
 		return;
 	}
-	if (!var->m_readCallback || var->m_readCallbackRunning) return;
+	if (var->m_readCallbackRunning) return;
+	// asynchronous read, serve current value and update it when the future finishes
+	if (var->m_asyncReadCallback)
+	{
+		var->startAsyncRead();
+		return;
+	}
+	if (!var->m_readCallback) return;
 	// setValue (somehow) triggers read callback again; this avoids recursion
 	QVariant newValue = var->m_readCallback();
 	if (!newValue.isNull())
@@ -120,6 +213,178 @@ void QUaBaseVariable::onRead(UA_Server             *server,
 	}
 }
 
+// [STATIC]
+UA_StatusCode QUaBaseVariable::onDataSourceRead(UA_Server             *server, 
+		                                        const UA_NodeId       *sessionId,
+		                                        void                  *sessionContext, 
+		                                        const UA_NodeId       *nodeId,
+		                                        void                  *nodeContext, 
+		                                        UA_Boolean             includeSourceTimeStamp,
+		                                        const UA_NumericRange *range,
+		                                        UA_DataValue          *value)
+{
+	Q_UNUSED(server);
+	Q_UNUSED(sessionContext);
+	Q_UNUSED(nodeId);
+	QElapsedTimer timer;
+	timer.start();
+	// get variable from context
+#ifdef QT_DEBUG 
+	auto var = dynamic_cast<QUaBaseVariable*>(static_cast<QObject*>(nodeContext));
+	Q_CHECK_PTR(var);
+#else
+	auto var = static_cast<QUaBaseVariable*>(nodeContext);
+#endif // QT_DEBUG 
+	if (!var)
+	{
+		return UA_STATUSCODE_BADINTERNALERROR;
+	}
+	UA_StatusCode st = UA_STATUSCODE_GOOD;
+	// bound to application memory
+	if (var->m_dataSourceData)
+	{
+		UA_Variant memValue;
+		if (var->m_dataSourceArrayLength == 0)
+		{
+			UA_Variant_setScalar(&memValue, var->m_dataSourceData, var->m_dataSourceType);
+		}
+		else
+		{
+			UA_Variant_setArray(&memValue, var->m_dataSourceData, var->m_dataSourceArrayLength, var->m_dataSourceType);
+		}
+		// NOTE : always copy, sampling queues the value in notifications that outlive this call
+		st = range ?
+			UA_Variant_copyRange(&memValue, &value->value, *range) :
+			UA_Variant_copy(&memValue, &value->value);
+	}
+	// bound to user accessor
+	else
+	{
+		Q_ASSERT(var->m_dataSourceRead);
+		QVariant varValue = var->m_dataSourceRead();
+		if (var->m_dataType != QMetaType::UnknownType &&
+			!varValue.canConvert<QVariantList>() &&
+			varValue.canConvert(var->m_dataType))
+		{
+			varValue.convert(var->m_dataType);
+		}
+		UA_Variant tmpVar = QUaTypesConverter::uaVariantFromQVariant(varValue);
+		if (range)
+		{
+			st = UA_Variant_copyRange(&tmpVar, &value->value, *range);
+			UA_Variant_clear(&tmpVar);
+		}
+		else
+		{
+			// move ownership to response
+			value->value = tmpVar;
+		}
+	}
+	if (st != UA_STATUSCODE_GOOD)
+	{
+		return st;
+	}
+	value->hasValue = true;
+	if (includeSourceTimeStamp)
+	{
+		value->hasSourceTimestamp = true;
+		value->sourceTimestamp    = UA_DateTime_now();
+	}
+	// account client read (request already counted by access control)
+	QUaSession * session = var->m_qUaServer->sessionById(sessionId);
+	if (session)
+	{
+		session->addTraffic(timer.nsecsElapsed(), 0,
+			UA_calcSizeBinary(&value->value, &UA_TYPES[UA_TYPES_VARIANT]));
+	}
+	return UA_STATUSCODE_GOOD;
+}
+
+// [STATIC]
+UA_StatusCode QUaBaseVariable::onDataSourceWrite(UA_Server             *server, 
+		                                         const UA_NodeId       *sessionId,
+		                                         void                  *sessionContext, 
+		                                         const UA_NodeId       *nodeId,
+		                                         void                  *nodeContext, 
+		                                         const UA_NumericRange *range,
+		                                         const UA_DataValue    *value)
+{
+	Q_UNUSED(server);
+	Q_UNUSED(sessionContext);
+	Q_UNUSED(nodeId);
+	QElapsedTimer timer;
+	timer.start();
+	// get variable from context
+#ifdef QT_DEBUG 
+	auto var = dynamic_cast<QUaBaseVariable*>(static_cast<QObject*>(nodeContext));
+	Q_CHECK_PTR(var);
+#else
+	auto var = static_cast<QUaBaseVariable*>(nodeContext);
+#endif // QT_DEBUG 
+	if (!var)
+	{
+		return UA_STATUSCODE_BADINTERNALERROR;
+	}
+	// consume internal write flag first, so a failed internal write does not leave it set
+	bool bInternalWrite = var->m_bInternalWrite;
+	var->m_bInternalWrite = false;
+	// admission control (internal writes have no session)
+	QUaSession * session = bInternalWrite ? nullptr : var->m_qUaServer->sessionById(sessionId);
+	if (session && !var->m_qUaServer->admitRequest(session, QUaSession::Service::Write))
+	{
+		return UA_STATUSCODE_BADTOOMANYOPERATIONS;
+	}
+	// NOTE : index range writes not supported by data sources
+	if (range || !value->hasValue)
+	{
+		return UA_STATUSCODE_BADWRITENOTSUPPORTED;
+	}
+	// bound to application memory
+	if (var->m_dataSourceData)
+	{
+		const UA_Variant &newValue = value->value;
+		bool isScalar = UA_Variant_isScalar(&newValue);
+		if (newValue.type != var->m_dataSourceType ||
+			(var->m_dataSourceArrayLength == 0 && !isScalar) ||
+			(var->m_dataSourceArrayLength != 0 && (isScalar || newValue.arrayLength != var->m_dataSourceArrayLength)))
+		{
+			return UA_STATUSCODE_BADTYPEMISMATCH;
+		}
+		size_t count = isScalar ? 1 : newValue.arrayLength;
+		memcpy(var->m_dataSourceData, newValue.data, count * var->m_dataSourceType->memSize);
+	}
+	// bound to user accessor
+	else
+	{
+		if (!var->m_dataSourceWrite)
+		{
+			return UA_STATUSCODE_BADNOTWRITABLE;
+		}
+		if (!var->m_dataSourceWrite(QUaTypesConverter::uaVariantToQVariant(value->value)))
+		{
+			return UA_STATUSCODE_BADWRITENOTSUPPORTED;
+		}
+	}
+	// do not emit if value change is internal
+	if (bInternalWrite)
+	{
+		return UA_STATUSCODE_GOOD;
+	}
+	// account client write
+	if (session)
+	{
+		session->addRequest(QUaSession::Service::Write, timer.nsecsElapsed(),
+			UA_calcSizeBinary(value, &UA_TYPES[UA_TYPES_DATAVALUE]));
+	}
+	// last filtered value no longer valid
+	var->resetChangeFilter();
+	// notify immediately if enabled
+	var->notifyMonitoredItems();
+	// emit value changed
+	emit var->valueChanged(QUaTypesConverter::uaVariantToQVariant(value->value));
+	return UA_STATUSCODE_GOOD;
+}
+
 QUaBaseVariable::QUaBaseVariable(QUaServer *server)
 	: QUaNode(server)
 {
@@ -136,6 +401,20 @@ QUaBaseVariable::QUaBaseVariable(QUaServer *server)
 	setReadCallback();
 }
 
+QUaBaseVariable::~QUaBaseVariable()
+{
+	// release server slot if async read still in flight
+	if (m_asyncReadWatcher)
+	{
+		this->finishAsyncRead();
+	}
+	delete m_changeFilter;
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+	// monitored items are deleted along with the node
+	m_qUaServer->m_hashMonitoredItems.remove(this);
+#endif // UA_ENABLE_SUBSCRIPTIONS
+}
+
 void QUaBaseVariable::setReadCallback(const std::function<QVariant()>& readCallback){
 	UA_ValueCallback callback;
 	if (readCallback)
@@ -149,11 +428,244 @@ void QUaBaseVariable::setReadCallback(const std::function<QVariant()>& readCallb
 		callback.onRead = nullptr;
 		m_readCallback = readCallback;
 	}
+	// replaces asynchronous callback, if any
+	m_asyncReadCallback = nullptr;
+	if (m_asyncReadWatcher)
+	{
+		this->finishAsyncRead();
+	}
 	callback.onWrite = &QUaBaseVariable::onWrite;
 	// this replaces the previous callback, if any
 	UA_Server_setVariableNode_valueCallback(m_qUaServer->m_server, m_nodeId, callback);
 }
 
+void QUaBaseVariable::setReadCallbackAsync(
+	const std::function<QFuture<QVariant>()>& asyncReadCallback/* = std::function<QFuture<QVariant>()>()*/,
+	const quint32 &timeoutMs/* = 1000*/)
+{
+	// NOTE : open62541 cannot defer the read response, so the read is served with the
+	//        current (last good) value and the node is updated once the future finishes
+	// reset sync callback, also cancels any pending async read
+	this->setReadCallback();
+	if (!asyncReadCallback)
+	{
+		return;
+	}
+	m_asyncReadCallback     = asyncReadCallback;
+	m_asyncReadTimeout      = timeoutMs;
+	m_asyncReadHasGoodValue = false;
+	m_readCallbackRunning   = false;
+	UA_ValueCallback callback;
+	callback.onRead  = &QUaBaseVariable::onRead;
+	callback.onWrite = &QUaBaseVariable::onWrite;
+	UA_Server_setVariableNode_valueCallback(m_qUaServer->m_server, m_nodeId, callback);
+}
+
+void QUaBaseVariable::startAsyncRead()
+{
+	Q_ASSERT(m_asyncReadCallback);
+	// only one read in flight per variable
+	if (m_asyncReadWatcher)
+	{
+		return;
+	}
+	// check server limit, if reached keep serving last value
+	if (m_qUaServer->m_asyncReadsInFlight >= m_qUaServer->m_maxAsyncReadsInFlight)
+	{
+		return;
+	}
+	m_qUaServer->m_asyncReadsInFlight++;
+	auto watcher = new QFutureWatcher<QVariant>(this);
+	m_asyncReadWatcher = watcher;
+	// update value when finished
+	QObject::connect(watcher, &QFutureWatcher<QVariant>::finished, this,
+	[this, watcher]() {
+		// ignore if timed out or cancelled already
+		if (m_asyncReadWatcher != watcher)
+		{
+			return;
+		}
+		QVariant newValue;
+		if (!watcher->isCanceled() && watcher->future().resultCount() > 0)
+		{
+			newValue = watcher->result();
+		}
+		this->finishAsyncRead();
+		if (newValue.isNull())
+		{
+			return;
+		}
+		m_asyncReadHasGoodValue = true;
+		m_readCallbackRunning   = true;
+		this->setValue(newValue);
+		m_readCallbackRunning   = false;
+	});
+	// timeout, single shot is cancelled if watcher is deleted before
+	QTimer::singleShot(static_cast<int>(m_asyncReadTimeout), watcher,
+	[this, watcher]() {
+		if (m_asyncReadWatcher != watcher)
+		{
+			return;
+		}
+		this->finishAsyncRead();
+		// keep last good value but let client know is not fresh
+		this->setValueStatus(m_asyncReadHasGoodValue ?
+			UA_STATUSCODE_UNCERTAINLASTUSABLEVALUE :
+			UA_STATUSCODE_BADTIMEOUT
+		);
+	});
+	// start read
+	watcher->setFuture(m_asyncReadCallback());
+}
+
+void QUaBaseVariable::finishAsyncRead()
+{
+	Q_CHECK_PTR(m_asyncReadWatcher);
+	// NOTE : cancel only has effect on cancellable futures (e.g. QtConcurrent::mapped)
+	m_asyncReadWatcher->disconnect(this);
+	m_asyncReadWatcher->cancel();
+	m_asyncReadWatcher->deleteLater();
+	m_asyncReadWatcher = nullptr;
+	Q_ASSERT(m_qUaServer->m_asyncReadsInFlight > 0);
+	m_qUaServer->m_asyncReadsInFlight--;
+}
+
+void QUaBaseVariable::setDataSource(
+	const std::function<QVariant()> &readCallback,
+	const std::function<bool(const QVariant&)> &writeCallback/* = std::function<bool(const QVariant&)>()*/)
+{
+	Q_ASSERT_X(readCallback, "QUaBaseVariable::setDataSource", "Read callback is mandatory.");
+	if (!readCallback)
+	{
+		return;
+	}
+	m_dataSourceRead  = readCallback;
+	m_dataSourceWrite = writeCallback;
+	m_dataSourceData  = nullptr;
+	m_dataSourceType  = nullptr;
+	m_dataSourceArrayLength = 0;
+	this->setDataSourceInternal();
+}
+
+void QUaBaseVariable::setDataSourceMemoryInternal(void * data, const QMetaType::Type &type, const quint32 &arrayLength)
+{
+	Q_CHECK_PTR(data);
+	const UA_DataType * uaType = QUaTypesConverter::uaTypeFromQType(type);
+	Q_ASSERT_X(uaType && uaType->pointerFree, "QUaBaseVariable::setDataSourceMemory", "Unsupported memory type.");
+	if (!data || !uaType || !uaType->pointerFree)
+	{
+		return;
+	}
+	m_dataSourceRead  = nullptr;
+	m_dataSourceWrite = nullptr;
+	m_dataSourceData  = data;
+	m_dataSourceType  = uaType;
+	m_dataSourceArrayLength = arrayLength;
+	this->setDataSourceInternal();
+	// match dataType with memory, current value is already read from memory
+	auto st = UA_Server_writeDataType(m_qUaServer->m_server,
+		m_nodeId,
+		QUaTypesConverter::uaTypeNodeIdFromQType(type));
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+	m_dataType = type;
+}
+
+void QUaBaseVariable::setDataSourceInternal()
+{
+	Q_CHECK_PTR(m_qUaServer);
+	Q_ASSERT(!UA_NodeId_isNull(&m_nodeId));
+	// read callbacks not called for data sources
+	if (m_asyncReadWatcher)
+	{
+		this->finishAsyncRead();
+	}
+	m_readCallback      = nullptr;
+	m_asyncReadCallback = nullptr;
+	// already bound, accessors updated in place
+	if (m_bDataSource)
+	{
+		return;
+	}
+	// NOTE : open62541 frees the value stored in the nodestore
+	UA_DataSource dataSource;
+	dataSource.read  = &QUaBaseVariable::onDataSourceRead;
+	dataSource.write = &QUaBaseVariable::onDataSourceWrite;
+	auto st = UA_Server_setVariableNode_dataSource(m_qUaServer->m_server, m_nodeId, dataSource);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+	m_bDataSource = true;
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+	// data sources can change without notice, so sample them again
+	if (m_bExceptionBasedReporting)
+	{
+		m_qUaServer->setMonitoredItemsSampling(this, true);
+	}
+#endif // UA_ENABLE_SUBSCRIPTIONS
+}
+
+bool QUaBaseVariable::isDataSource() const
+{
+	return m_bDataSource;
+}
+
+void QUaBaseVariable::setValueStatus(const UA_StatusCode & status)
+{
+	Q_CHECK_PTR(m_qUaServer);
+	Q_ASSERT(!UA_NodeId_isNull(&m_nodeId));
+	// read current value, avoid triggering read callback
+	UA_ReadValueId rvi;
+	UA_ReadValueId_init(&rvi);
+	rvi.nodeId      = m_nodeId;
+	rvi.attributeId = UA_ATTRIBUTEID_VALUE;
+	m_readCallbackRunning = true;
+	UA_DataValue dataValue = UA_Server_read(m_qUaServer->m_server, &rvi, UA_TIMESTAMPSTORETURN_NEITHER);
+	m_readCallbackRunning = false;
+	// write back with new status
+	UA_WriteValue wv;
+	UA_WriteValue_init(&wv);
+	wv.nodeId          = m_nodeId;
+	wv.attributeId     = UA_ATTRIBUTEID_VALUE;
+	wv.value           = dataValue;
+	wv.value.hasStatus = true;
+	wv.value.status    = status;
+	m_bInternalWrite = true;
+	auto st = UA_Server_write(m_qUaServer->m_server, &wv);
+	// NOTE : can fail if no value has ever been set (type mismatch on empty variant)
+	if (st != UA_STATUSCODE_GOOD)
+	{
+		m_bInternalWrite = false;
+	}
+	// clean up
+	UA_DataValue_clear(&dataValue);
+}
+
+UA_StatusCode QUaBaseVariable::readValueInternal(UA_Variant & value)
+{
+	Q_CHECK_PTR(m_qUaServer);
+	Q_ASSERT(!UA_NodeId_isNull(&m_nodeId));
+	// bound to application memory, read it in place
+	if (m_dataSourceData)
+	{
+		if (m_dataSourceArrayLength == 0)
+		{
+			UA_Variant_setScalar(&value, m_dataSourceData, m_dataSourceType);
+		}
+		else
+		{
+			UA_Variant_setArray(&value, m_dataSourceData, m_dataSourceArrayLength, m_dataSourceType);
+		}
+		value.storageType = UA_VARIANT_DATA_NODELETE;
+		return UA_STATUSCODE_GOOD;
+	}
+	// read the stored value, avoid calling the read callbacks
+	bool readCallbackRunning = m_readCallbackRunning;
+	m_readCallbackRunning = true;
+	auto st = UA_Server_readValue(m_qUaServer->m_server, m_nodeId, &value);
+	m_readCallbackRunning = readCallbackRunning;
+	return st;
+}
+
 QVariant QUaBaseVariable::value() const
 {
 	Q_CHECK_PTR(m_qUaServer);
@@ -175,9 +687,24 @@ QVariant QUaBaseVariable::value() const
 }
 
 void QUaBaseVariable::setValue(const QVariant & value, QMetaType::Type newType/* = QMetaType::UnknownType*/)
+{
+	this->setValueInternal(value, newType, 0);
+}
+
+void QUaBaseVariable::setValue(const QVariant & value, const QUaDateTime & sourceTimestamp, QMetaType::Type newType/* = QMetaType::UnknownType*/)
+{
+	this->setValueInternal(value, newType, sourceTimestamp.ticks());
+}
+
+void QUaBaseVariable::setValueInternal(const QVariant & value, QMetaType::Type newType, const UA_DateTime & sourceTimestamp)
 {
 	Q_CHECK_PTR(m_qUaServer);
 	Q_ASSERT(!UA_NodeId_isNull(&m_nodeId));
+	// skip update if filtered out
+	if (m_changeFilter && m_changeFilter->skipValue(value))
+	{
+		return;
+	}
 	if (newType == QMetaType::UnknownType)
 	{
 		newType = (QMetaType::Type)value.type();
@@ -187,7 +714,19 @@ void QUaBaseVariable::setValue(const QVariant & value, QMetaType::Type newType/*
 	// get types
 	auto oldType = this->dataType();
 	// if variant list we need to adjust newType
-	if (newValue.canConvert<QVariantList>())
+	QMetaType::Type leafType = QMetaType::UnknownType;
+	if (newValue.canConvert<QVariantList>() &&
+		QUaTypesConverter::getQVariantDimensions(newValue, &leafType).size() > 1)
+	{
+		// multidimensional array (nested lists), leaves are converted by the types converter
+		if (newType == QMetaType::UnknownType || newType == QMetaType::User || newType == QMetaType::QVariantList)
+		{
+			// preserve dataType if possible
+			newType = oldType != QMetaType::UnknownType &&
+				      QVariant(leafType, nullptr).canConvert(oldType) ? oldType : leafType;
+		}
+	}
+	else if (newValue.canConvert<QVariantList>())
 	{
 		auto iter = newValue.value<QSequentialIterable>();
 		// TODO : [BUG] what happens if iter size is zero !?
@@ -236,30 +775,100 @@ void QUaBaseVariable::setValue(const QVariant & value, QMetaType::Type newType/*
 		newValue.convert(oldType);
 		newType = oldType;
 	}
-	// if new value dataType does not match the old value dataType
-	// first set type to UA_NS0ID_BASEDATATYPE to avoid "BadTypeMismatch"	
-	if (newType != oldType &&
-		!newValue.canConvert(oldType))
+	// if new value dataType does not match and is not convertible to the old value dataType
+	bool changeType = newType != oldType && !newValue.canConvert(oldType);
+	// convert to UA_Variant and set new value
+	auto tmpVar = QUaTypesConverter::uaVariantFromQVariant(newValue, newType);
+	this->writeValueInternal(tmpVar, newType, changeType, sourceTimestamp);
+	// clean up
+	UA_Variant_clear(&tmpVar);
+	// update filter
+	if (m_changeFilter)
+	{
+		m_changeFilter->lastValue = newValue;
+		m_changeFilter->lastTime.start();
+	}
+	// notify immediately if enabled
+	this->notifyMonitoredItems();
+}
+
+void QUaBaseVariable::setValueArrayInternal(const UA_Variant & uaValue, const QMetaType::Type & newType)
+{
+	Q_CHECK_PTR(m_qUaServer);
+	Q_ASSERT(!UA_NodeId_isNull(&m_nodeId));
+	// only convert back if the filter needs it
+	QVariant value;
+	if (m_changeFilter)
+	{
+		value = QUaTypesConverter::uaVariantToQVariant(uaValue);
+		if (m_changeFilter->skipValue(value))
+		{
+			return;
+		}
+	}
+	this->writeValueInternal(uaValue, newType, newType != m_dataType, 0);
+	// update filter
+	if (m_changeFilter)
+	{
+		m_changeFilter->lastValue = value;
+		m_changeFilter->lastTime.start();
+	}
+	// notify immediately if enabled
+	this->notifyMonitoredItems();
+}
+
+void QUaBaseVariable::writeValueInternal(const UA_Variant & uaValue, const QMetaType::Type & newType, const bool & changeType, const UA_DateTime & sourceTimestamp)
+{
+	UA_StatusCode st;
+	// first set type to UA_NS0ID_BASEDATATYPE to avoid "BadTypeMismatch"
+	if (changeType)
 	{
-		auto st = UA_Server_writeDataType(m_qUaServer->m_server,
+		st = UA_Server_writeDataType(m_qUaServer->m_server,
 			m_nodeId,
 			UA_NODEID_NUMERIC(0, UA_NS0ID_BASEDATATYPE));
 		Q_ASSERT(st == UA_STATUSCODE_GOOD);
 		Q_UNUSED(st);
 	}
-	// convert to UA_Variant and set new value
-	auto tmpVar = QUaTypesConverter::uaVariantFromQVariant(newValue, newType);
+	// multidimensional values constrain valueRank and arrayDimensions to their shape,
+	// if the shape changes first release the old constraint to avoid "BadTypeMismatch"
+	QVector<quint32> newDimensions;
+	if (uaValue.arrayDimensionsSize > 1)
+	{
+		newDimensions.resize(static_cast<int>(uaValue.arrayDimensionsSize));
+		QUaTypesConverter::numericArrayCopy(newDimensions.data(), uaValue.arrayDimensions, uaValue.arrayDimensionsSize);
+	}
+	bool shapeChanged = newDimensions != m_arrayDimensions;
+	if (shapeChanged && !m_arrayDimensions.isEmpty())
+	{
+		st = m_qUaServer->writeValueShape(m_nodeId, UA_VALUERANK_ANY, QVector<quint32>());
+		Q_ASSERT(st == UA_STATUSCODE_GOOD);
+		Q_UNUSED(st);
+	}
+	// write value
 	m_bInternalWrite = true;
-	auto st = UA_Server_writeValue(m_qUaServer->m_server,
-		m_nodeId,
-		tmpVar);
+	if (sourceTimestamp == 0)
+	{
+		st = UA_Server_writeValue(m_qUaServer->m_server,
+			m_nodeId,
+			uaValue);
+	}
+	else
+	{
+		// write with source timestamp
+		UA_WriteValue wv;
+		UA_WriteValue_init(&wv);
+		wv.nodeId                   = m_nodeId;
+		wv.attributeId              = UA_ATTRIBUTEID_VALUE;
+		wv.value.value              = uaValue;
+		wv.value.hasValue           = true;
+		wv.value.sourceTimestamp    = sourceTimestamp;
+		wv.value.hasSourceTimestamp = true;
+		st = UA_Server_write(m_qUaServer->m_server, &wv);
+	}
 	Q_ASSERT(st == UA_STATUSCODE_GOOD);
 	Q_UNUSED(st);
-	// clean up
-	UA_Variant_clear(&tmpVar);
 	// set new dataType if necessary
-	if (newType != oldType &&
-		!newValue.canConvert(oldType))
+	if (changeType)
 	{
 		st = UA_Server_writeDataType(m_qUaServer->m_server,
 			m_nodeId,
@@ -267,8 +876,19 @@ void QUaBaseVariable::setValue(const QVariant & value, QMetaType::Type newType/*
 		Q_ASSERT(st == UA_STATUSCODE_GOOD);
 		Q_UNUSED(st);
 	}
-	// [NOTE] do not set rank or arrayDimensions because they are permanent
-	//        is better to just set array dimensions on Variant value and leave rank as ANY
+	// constrain to new shape, scalars and one dimensional arrays leave rank as ANY
+	if (shapeChanged)
+	{
+		qint32 valueRank = newDimensions.isEmpty() ? UA_VALUERANK_ANY : newDimensions.size();
+		if (!newDimensions.isEmpty())
+		{
+			st = m_qUaServer->writeValueShape(m_nodeId, valueRank, newDimensions);
+			Q_ASSERT(st == UA_STATUSCODE_GOOD);
+			Q_UNUSED(st);
+		}
+		m_arrayDimensions = newDimensions;
+		emit this->valueRankChanged(valueRank);
+	}
 	// update cache
 	m_dataType = newType;
 	//Q_ASSERT(this->dataTypeInternal() == m_type);
@@ -376,6 +996,7 @@ void QUaBaseVariable::setDataType(const QMetaType::Type & dataType)
 	// update cache
 	m_dataType = dataType;
 	Q_ASSERT(this->dataTypeInternal() == m_dataType);
+	this->resetChangeFilter();
 }
 
 void QUaBaseVariable::setDataTypeEnum(const QMetaEnum & metaEnum)
@@ -465,6 +1086,7 @@ void QUaBaseVariable::setDataTypeEnum(const UA_NodeId & enumTypeNodeId)
 	// update cache
 	m_dataType = QMetaType::Int;
 	Q_ASSERT(this->dataTypeInternal() == m_dataType);
+	this->resetChangeFilter();
 }
 
 QMetaType::Type QUaBaseVariable::dataTypeInternal() const
@@ -655,6 +1277,120 @@ void QUaBaseVariable::setHistorizing(const bool& historizing)
 }
 #endif // UA_ENABLE_HISTORIZING
 
+bool QUaBaseVariable::filterUnchanged() const
+{
+	return m_changeFilter ? m_changeFilter->filterUnchanged : false;
+}
+
+void QUaBaseVariable::setFilterUnchanged(const bool & filterUnchanged)
+{
+	this->changeFilter()->filterUnchanged = filterUnchanged;
+	this->resetChangeFilter();
+}
+
+QUaDeadbandType QUaBaseVariable::deadbandType() const
+{
+	return m_changeFilter ? m_changeFilter->deadbandType : QUaDeadbandType::None;
+}
+
+double QUaBaseVariable::deadbandValue() const
+{
+	return m_changeFilter ? m_changeFilter->deadbandValue : 0.0;
+}
+
+void QUaBaseVariable::setDeadband(const QUaDeadbandType & deadbandType, const double & deadbandValue)
+{
+	Q_ASSERT_X(deadbandValue >= 0.0, "QUaBaseVariable::setDeadband", "Deadband value cannot be negative.");
+	Q_ASSERT_X(deadbandType != QUaDeadbandType::Percent || deadbandValue <= 100.0, "QUaBaseVariable::setDeadband", "Percent deadband must be within [0, 100].");
+	auto filter = this->changeFilter();
+	filter->deadbandType  = deadbandType;
+	filter->deadbandValue = qAbs(deadbandValue);
+	this->resetChangeFilter();
+}
+
+void QUaBaseVariable::setDeadbandRange(const double & low, const double & high)
+{
+	Q_ASSERT_X(high >= low, "QUaBaseVariable::setDeadbandRange", "Invalid range.");
+	auto filter = this->changeFilter();
+	filter->rangeLow  = low;
+	filter->rangeHigh = high;
+}
+
+quint32 QUaBaseVariable::minUpdateInterval() const
+{
+	return m_changeFilter ? m_changeFilter->minInterval : 0;
+}
+
+void QUaBaseVariable::setMinUpdateInterval(const quint32 & minUpdateInterval)
+{
+	this->changeFilter()->minInterval = minUpdateInterval;
+	this->resetChangeFilter();
+}
+
+bool QUaBaseVariable::exceptionBasedReporting() const
+{
+	return m_bExceptionBasedReporting;
+}
+
+void QUaBaseVariable::setExceptionBasedReporting(const bool & exceptionBasedReporting)
+{
+	if (m_bExceptionBasedReporting == exceptionBasedReporting)
+	{
+		return;
+	}
+	m_bExceptionBasedReporting = exceptionBasedReporting;
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+	// data sources can change without notice, so keep sampling them
+	if (m_bDataSource)
+	{
+		return;
+	}
+	// stop or restart periodic sampling of existing monitored items
+	m_qUaServer->setMonitoredItemsSampling(this, !m_bExceptionBasedReporting);
+#endif // UA_ENABLE_SUBSCRIPTIONS
+}
+
+void QUaBaseVariable::notifyMonitoredItems()
+{
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+	if (!m_bExceptionBasedReporting)
+	{
+		return;
+	}
+	// NOTE : sampling reads the value, avoid calling the read callbacks
+	bool readCallbackRunning = m_readCallbackRunning;
+	m_readCallbackRunning = true;
+	m_qUaServer->triggerMonitoredItems(this);
+	m_readCallbackRunning = readCallbackRunning;
+#endif // UA_ENABLE_SUBSCRIPTIONS
+}
+
+QUaChangeFilter * QUaBaseVariable::changeFilter()
+{
+	if (!m_changeFilter)
+	{
+		m_changeFilter = new QUaChangeFilter;
+	}
+	return m_changeFilter;
+}
+
+void QUaBaseVariable::resetChangeFilter()
+{
+	if (!m_changeFilter)
+	{
+		return;
+	}
+	// free if all filters disabled
+	if (!m_changeFilter->isEnabled())
+	{
+		delete m_changeFilter;
+		m_changeFilter = nullptr;
+		return;
+	}
+	m_changeFilter->lastValue = QVariant();
+	m_changeFilter->lastTime.invalidate();
+}
+
 bool QUaBaseVariable::readAccess() const
 {
 	QUaAccessLevel accessLevel;
@@ -726,7 +1462,8 @@ qint32 QUaBaseVariable::GetValueRankFromQVariant(const QVariant & varValue)
 	}
 	else if (varValue.canConvert<QVariantList>())
 	{
-		return UA_VALUERANK_ONE_DIMENSION;
+		auto dims = QUaTypesConverter::getQVariantDimensions(varValue);
+		return dims.size() > 1 ? dims.size() : UA_VALUERANK_ONE_DIMENSION;
 	}
 	// scalar is default
 	return UA_VALUERANK_SCALAR;
@@ -735,12 +1472,6 @@ qint32 QUaBaseVariable::GetValueRankFromQVariant(const QVariant & varValue)
 // [STATIC]
 QVector<quint32> QUaBaseVariable::GetArrayDimensionsFromQVariant(const QVariant & varValue)
 {
-	if (varValue.canConvert<QVariantList>())
-	{
-		auto iter = varValue.value<QSequentialIterable>();
-		auto size = (quint32)iter.size();
-		return QVector<quint32>() << size;
-	}
-	// default arrayDimensionsSize == 0
-	return QVector<quint32>();
+	// one entry per dimension of (nested) lists, default arrayDimensionsSize == 0
+	return QUaTypesConverter::getQVariantDimensions(varValue);
 }
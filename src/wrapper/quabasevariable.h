@@ -2,6 +2,9 @@
 #define QUABASEVARIABLE_H
 
 #include <QUaNode>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QElapsedTimer>
 
 /*
 typedef struct {                          // UA_VariableTypeAttributes_default
@@ -67,9 +70,32 @@ private:
 
 Q_DECLARE_METATYPE(QUaDataType);
 
+// settings and state used by QUaBaseVariable::setValue to skip updates,
+// only allocated if any filter is enabled
+struct QUaChangeFilter
+{
+	bool            filterUnchanged = false;
+	QUaDeadbandType deadbandType    = QUaDeadbandType::None;
+	double          deadbandValue   = 0.0;
+	double          rangeLow        = 0.0;
+	double          rangeHigh       = 0.0;
+	quint32         minInterval     = 0;
+	// last accepted value and time
+	QVariant        lastValue;
+	QElapsedTimer   lastTime;
+
+	bool isEnabled() const;
+	bool skipValue(const QVariant &value) const;
+	bool exceedsDeadband(const QVariant &value, const QVariant &oldValue) const;
+};
+
 class QUaBaseVariable : public QUaNode
 {
 	Q_OBJECT
+
+friend class QUaServer;
+friend class QUaLimitAlarms;
+
 	// Variable Attributes
 
 	Q_PROPERTY(QVariant          value               READ value               WRITE setValue           NOTIFY valueChanged          )
@@ -92,6 +118,7 @@ class QUaBaseVariable : public QUaNode
 
 public:
 	explicit QUaBaseVariable(QUaServer *server);
+	~QUaBaseVariable();
 
 	// Attributes API
 
@@ -100,6 +127,13 @@ public:
 	// Use QVariant::fromValue or use casting to force a dataType
 	QVariant          value() const;
 	void              setValue(const QVariant &value, QMetaType::Type newType = QMetaType::UnknownType);
+	// Same as above but also writes the source timestamp with full (100 ns) precision
+	void              setValue(const QVariant &value, const QUaDateTime &sourceTimestamp, QMetaType::Type newType = QMetaType::UnknownType);
+	// Set an N-dimensional numeric value from a contiguous buffer in row-major order (last dimension varies fastest)
+	// The dataType is set to the buffer type. Nested QVariantLists can also be passed to setValue for N-dimensional values
+	// In both cases valueRank and arrayDimensions are kept in sync with the shape of the value
+	template<typename T>
+	void              setValueArray(const T *data, const QVector<quint32> &arrayDimensions);
 	// If there is no old value, a default value is assigned with the new dataType
 	// If an old value exists and is convertible to the new dataType then the value is converted
 	// If the old value is not convertible, then a default value is assigned with the new dataType and the old value is lost
@@ -109,7 +143,7 @@ public:
 	void              setDataTypeEnum();
 	void              setDataTypeEnum(const QMetaEnum &metaEnum);
 	bool              setDataTypeEnum(const QString &strEnumName);
-	// Read-only, values set automatically when calling setValue
+	// Read-only, values set automatically when calling setValue with multidimensional values
 	// NOTE : includes arrayDimensionsSize
 	qint32            valueRank() const;
 	void              setValueRank(const qint32& valueRank);
@@ -132,6 +166,53 @@ public:
 	// set callback which is called before a read is performed
 	// call with the default argument for no pre-read callback
 	void              setReadCallback(const std::function<QVariant()>& readCallback=std::function<QVariant()>());
+	// set asynchronous callback which is called before a read is performed, the read is served immediately
+	// with the last good value and the value is updated when the returned future finishes
+	// if the future does not finish within timeoutMs, the value status is set to Bad (no good value yet)
+	// or Uncertain (last good value kept), the number of reads in flight is limited by the server
+	// call with the default argument for no asynchronous pre-read callback
+	void              setReadCallbackAsync(const std::function<QFuture<QVariant>()>& asyncReadCallback=std::function<QFuture<QVariant>()>(), 
+		                                   const quint32 &timeoutMs = 1000);
+
+	// Data Source API
+
+	// bind the value to user accessors, the value is no longer stored in the nodestore
+	// client reads and writes go directly to the accessors, setValue calls the write accessor
+	// NOTE : binding is permanent and read callbacks (setReadCallback, setReadCallbackAsync) are not called anymore
+	void              setDataSource(const std::function<QVariant()> &readCallback,
+		                            const std::function<bool(const QVariant&)> &writeCallback = std::function<bool(const QVariant&)>());
+	// bind the value to application memory, read responses copy the memory without QVariant conversion
+	// arrayLength = 0 binds a scalar, memory must remain valid while the variable exists
+	template<typename T>
+	void              setDataSourceMemory(T * data, const quint32 &arrayLength = 0);
+	// true if value is bound to a data source
+	bool              isDataSource() const;
+
+	// Change Filter API
+
+	// Evaluated in setValue before writing, skipped values do not reach the nodestore,
+	// monitored items nor the history backend. All filters are disabled by default.
+	// If true, values equal to the last value are skipped
+	bool              filterUnchanged() const;
+	void              setFilterUnchanged(const bool &filterUnchanged);
+	// Numeric values (or arrays) whose change is within the deadband are skipped.
+	// Percent deadband is relative to the range set with setDeadbandRange (EURange),
+	// if no range is set it is relative to the last value
+	QUaDeadbandType   deadbandType() const;
+	double            deadbandValue() const;
+	void              setDeadband(const QUaDeadbandType &deadbandType, const double &deadbandValue);
+	void              setDeadbandRange(const double &low, const double &high);
+	// Values set before this interval (in milliseconds) elapses since last accepted value are skipped
+	quint32           minUpdateInterval() const;
+	void              setMinUpdateInterval(const quint32 &minUpdateInterval);
+
+	// Monitored Items API
+
+	// If true, setValue and client writes notify the monitored items of this variable immediately
+	// (exception based reporting) and their periodic sampling is stopped, unless the variable
+	// is bound to a data source. Default false
+	bool              exceptionBasedReporting() const;
+	void              setExceptionBasedReporting(const bool &exceptionBasedReporting);
 
 	// Helpers
 
@@ -160,7 +241,7 @@ public:
 	
 signals:
 	void valueChanged(const QVariant &value);
-	void valueRankChanged(const quint32 &valueRank);
+	void valueRankChanged(const qint32 &valueRank);
 
 private:
 	static void onWrite(UA_Server             *server, 
@@ -179,11 +260,65 @@ private:
 		                const UA_NumericRange *range,
 		                const UA_DataValue    *data);
 
+	static UA_StatusCode onDataSourceRead (UA_Server             *server, 
+		                                   const UA_NodeId       *sessionId,
+		                                   void                  *sessionContext, 
+		                                   const UA_NodeId       *nodeId,
+		                                   void                  *nodeContext, 
+		                                   UA_Boolean             includeSourceTimeStamp,
+		                                   const UA_NumericRange *range,
+		                                   UA_DataValue          *value);
+
+	static UA_StatusCode onDataSourceWrite(UA_Server             *server, 
+		                                   const UA_NodeId       *sessionId,
+		                                   void                  *sessionContext, 
+		                                   const UA_NodeId       *nodeId,
+		                                   void                  *nodeContext, 
+		                                   const UA_NumericRange *range,
+		                                   const UA_DataValue    *value);
+
 	// cache type for performance
 	QMetaType::Type m_dataType; 
 	bool m_bInternalWrite;
 	std::function<QVariant()> m_readCallback;
 	bool m_readCallbackRunning = false;
+	// async read
+	std::function<QFuture<QVariant>()> m_asyncReadCallback;
+	QFutureWatcher<QVariant> * m_asyncReadWatcher = nullptr;
+	quint32 m_asyncReadTimeout = 1000;
+	bool m_asyncReadHasGoodValue = false;
+
+	// monitored items
+	bool m_bExceptionBasedReporting = false;
+	void notifyMonitoredItems();
+	// change filter
+	QUaChangeFilter * m_changeFilter = nullptr;
+	QUaChangeFilter * changeFilter();
+	void resetChangeFilter();
+	// NOTE : sourceTimestamp is not written if zero
+	void setValueInternal(const QVariant &value, QMetaType::Type newType, const UA_DateTime &sourceTimestamp);
+	void setValueArrayInternal(const UA_Variant &uaValue, const QMetaType::Type &newType);
+	// writes converted value, updates dataType if changeType and keeps valueRank, arrayDimensions in sync
+	void writeValueInternal(const UA_Variant &uaValue, const QMetaType::Type &newType, const bool &changeType, const UA_DateTime &sourceTimestamp);
+	// shape of last multidimensional value, empty if valueRank and arrayDimensions are not constrained
+	QVector<quint32> m_arrayDimensions;
+	// data source
+	bool m_bDataSource = false;
+	std::function<QVariant()> m_dataSourceRead;
+	std::function<bool(const QVariant&)> m_dataSourceWrite;
+	void              * m_dataSourceData = nullptr;
+	const UA_DataType * m_dataSourceType = nullptr;
+	quint32             m_dataSourceArrayLength = 0;
+
+	void setDataSourceInternal();
+	void setDataSourceMemoryInternal(void * data, const QMetaType::Type &type, const quint32 &arrayLength);
+
+	void startAsyncRead();
+	void finishAsyncRead();
+	void setValueStatus(const UA_StatusCode &status);
+	// reads the current value without calling read callbacks (accessor data sources are called)
+	// NOTE : memory bound values are not copied (NODELETE), value must be cleared if good
+	UA_StatusCode readValueInternal(UA_Variant &value);
 
 	void setDataTypeEnum(const UA_NodeId &enumTypeNodeId);
 	QMetaType::Type dataTypeInternal() const;
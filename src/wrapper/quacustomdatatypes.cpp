@@ -13,3 +13,57 @@ QUaChangeStructureDataType::QUaChangeStructureDataType(const QString & strNodeId
 	  m_uiVerb(uiVerb)
 {
 }
+
+QUaDateTime::QUaDateTime()
+	: m_ticks(0)
+{
+}
+
+QUaDateTime::QUaDateTime(const UA_DateTime & ticks)
+	: m_ticks(ticks)
+{
+}
+
+QUaDateTime::QUaDateTime(const QDateTime & dateTime)
+	: m_ticks(0)
+{
+	if (!dateTime.isValid())
+	{
+		return;
+	}
+	m_ticks = dateTime.toMSecsSinceEpoch() * UA_DATETIME_MSEC + UA_DATETIME_UNIX_EPOCH;
+}
+
+QUaDateTime::operator QDateTime() const
+{
+	return this->toDateTime();
+}
+
+bool QUaDateTime::isValid() const
+{
+	return m_ticks != 0;
+}
+
+qint64 QUaDateTime::toMSecsSinceEpoch() const
+{
+	return (m_ticks - UA_DATETIME_UNIX_EPOCH) / UA_DATETIME_MSEC;
+}
+
+QDateTime QUaDateTime::toDateTime() const
+{
+	if (!this->isValid())
+	{
+		return QDateTime();
+	}
+	return QDateTime::fromMSecsSinceEpoch(this->toMSecsSinceEpoch());
+}
+
+QUaDateTime QUaDateTime::fromMSecsSinceEpoch(const qint64 & msecs)
+{
+	return QUaDateTime(msecs * UA_DATETIME_MSEC + UA_DATETIME_UNIX_EPOCH);
+}
+
+QUaDateTime QUaDateTime::currentDateTime()
+{
+	return QUaDateTime(UA_DateTime_now());
+}
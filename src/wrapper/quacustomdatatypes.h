@@ -6,6 +6,8 @@
 #include <QUuid>
 #include <QRegularExpression>
 #include <QDate>
+#include <QDateTime>
+#include <QHash>
 #include <QTimeZone>
 #include <QDebug>
 
@@ -56,4 +58,48 @@ inline bool operator==(const QUaChangeStructureDataType& lhs, const QUaChangeStr
 
 Q_DECLARE_METATYPE(QUaChangeStructureDataType);
 
+// OPC UA DateTime, 100 nanosecond ticks since 1601-01-01 UTC (part 6, 5.2.2.5)
+// Cheap to copy, compare and hash, and keeps full precision unlike QDateTime (milliseconds)
+// Implicitly converts from QDateTime (invalid maps to zero ticks), explicitly to QDateTime
+// NOTE : registered by QUaServer::setupServer, not on first use, so it never takes a METATYPE_* id
+class QUaDateTime
+{
+public:
+	QUaDateTime();
+	explicit QUaDateTime(const UA_DateTime &ticks);
+	QUaDateTime(const QDateTime &dateTime);
+
+	explicit operator QDateTime() const;
+
+	bool        isValid() const;
+	UA_DateTime ticks() const;
+	qint64      toMSecsSinceEpoch() const;
+	QDateTime   toDateTime() const;
+
+	static QUaDateTime fromMSecsSinceEpoch(const qint64 &msecs);
+	static QUaDateTime currentDateTime();
+
+private:
+	UA_DateTime m_ticks;
+};
+
+inline UA_DateTime QUaDateTime::ticks() const
+{
+	return m_ticks;
+}
+
+inline bool operator==(const QUaDateTime &lhs, const QUaDateTime &rhs) { return lhs.ticks() == rhs.ticks(); }
+inline bool operator!=(const QUaDateTime &lhs, const QUaDateTime &rhs) { return lhs.ticks() != rhs.ticks(); }
+inline bool operator< (const QUaDateTime &lhs, const QUaDateTime &rhs) { return lhs.ticks() <  rhs.ticks(); }
+inline bool operator<=(const QUaDateTime &lhs, const QUaDateTime &rhs) { return lhs.ticks() <= rhs.ticks(); }
+inline bool operator> (const QUaDateTime &lhs, const QUaDateTime &rhs) { return lhs.ticks() >  rhs.ticks(); }
+inline bool operator>=(const QUaDateTime &lhs, const QUaDateTime &rhs) { return lhs.ticks() >= rhs.ticks(); }
+
+inline uint qHash(const QUaDateTime &key, uint seed = 0)
+{
+	return qHash(key.ticks(), seed);
+}
+
+Q_DECLARE_METATYPE(QUaDateTime);
+
 #endif // QUACUSTOMDATATYPES_H
@@ -11,7 +11,7 @@ const QStringList QUaGeneralModelChangeEvent::DefaultProperties =
 QUaGeneralModelChangeEvent::QUaGeneralModelChangeEvent(QUaServer *server)
 	: QUaBaseEvent(server)
 {
-	
+	m_changes = this->findChild<QUaProperty*>("Changes");
 }
 
 QUaChangesList QUaGeneralModelChangeEvent::changes() const
@@ -37,7 +37,7 @@ void QUaGeneralModelChangeEvent::setChanges(const QUaChangesList & listVerbs)
 
 QUaProperty * QUaGeneralModelChangeEvent::getChanges() const
 {
-	return this->findChild<QUaProperty*>("Changes");
+	return m_changes;
 }
 
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
\ No newline at end of file
@@ -36,6 +36,7 @@ public:
 private:
 	// ChangeStructureDataType (PArt 5 - 11.14) : UA_ModelChangeStructureDataType
 	QUaProperty * getChanges() const;
+	QUaProperty * m_changes;
 
 };
 
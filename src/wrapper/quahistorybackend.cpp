@@ -2,6 +2,8 @@
 
 #include <QUaServer>
 
+#include <QElapsedTimer>
+
 #ifdef UA_ENABLE_HISTORIZING
 
 UA_StatusCode UA_DataValue_backend_copyRange(
@@ -34,7 +36,7 @@ QUaHistoryDataPoint QUaHistoryBackend::dataValueToPoint(const UA_DataValue* valu
 		timestamp = UA_DateTime_now();
 	}
 	return {
-			QUaTypesConverter::uaVariantToQVariantScalar<QDateTime, UA_DateTime>(&timestamp),
+			QUaDateTime(timestamp),
 			QUaTypesConverter::uaVariantToQVariant(value->value),
 			value->status
 	};
@@ -45,8 +47,8 @@ UA_DataValue QUaHistoryBackend::dataPointToValue(const QUaHistoryDataPoint* poin
 	UA_DataValue retVal;
 	// set values
 	retVal.value = QUaTypesConverter::uaVariantFromQVariant(point->value);
-	QUaTypesConverter::uaVariantFromQVariantScalar<UA_DateTime, QDateTime>(point->timestamp, &retVal.serverTimestamp);
-	QUaTypesConverter::uaVariantFromQVariantScalar<UA_DateTime, QDateTime>(point->timestamp, &retVal.sourceTimestamp);
+	retVal.serverTimestamp = point->timestamp.ticks();
+	retVal.sourceTimestamp = point->timestamp.ticks();
 	retVal.status = point->status;
 	retVal.serverPicoseconds = 0;
 	retVal.hasSourcePicoseconds = 0;
@@ -173,8 +175,8 @@ UA_HistoryDataBackend QUaHistoryBackend::CreateUaBackend()
 		// get server
 		QQueue<QUaLog> logOut;
 		QUaServer* srv = QUaServer::getServerNodeContext(server);
-		// simplify API by considering that the timestamp is the index
-		QDateTime time = srv->m_historBackend.firstTimestamp(
+		// simplify API by considering that the timestamp (in ticks) is the index
+		QUaDateTime time = srv->m_historBackend.firstTimestamp(
 			QUaTypesConverter::nodeIdToQString(*nodeId),
 			logOut
 		);
@@ -185,7 +187,7 @@ UA_HistoryDataBackend QUaHistoryBackend::CreateUaBackend()
 			return LLONG_MAX;
 		}
 		// return first available timestamp as index
-		return static_cast<size_t>(time.toMSecsSinceEpoch());
+		return static_cast<size_t>(time.ticks());
 	};
 	// 5) It returns the index of the last element in the database for a node.
 	result.lastIndex = [](
@@ -201,8 +203,8 @@ UA_HistoryDataBackend QUaHistoryBackend::CreateUaBackend()
 		// get server
 		QQueue<QUaLog> logOut;
 		QUaServer* srv = QUaServer::getServerNodeContext(server);
-		// simplify API by considering that the timestamp is the index
-		QDateTime time = srv->m_historBackend.lastTimestamp(
+		// simplify API by considering that the timestamp (in ticks) is the index
+		QUaDateTime time = srv->m_historBackend.lastTimestamp(
 			QUaTypesConverter::nodeIdToQString(*nodeId),
 			logOut
 		);
@@ -213,7 +215,7 @@ UA_HistoryDataBackend QUaHistoryBackend::CreateUaBackend()
 			return LLONG_MAX;
 		}
 		// return first available timestamp as index
-		return static_cast<size_t>(time.toMSecsSinceEpoch());
+		return static_cast<size_t>(time.ticks());
 	};
 	// 6) It returns the index of a value in the database which matches certain criteria.
 	result.getDateTimeMatch = [](UA_Server* server,
@@ -228,7 +230,7 @@ UA_HistoryDataBackend QUaHistoryBackend::CreateUaBackend()
 		Q_UNUSED(sessionId);
 		Q_UNUSED(sessionContext);
 		QString strNodeId = QUaTypesConverter::nodeIdToQString(*nodeId);
-		QDateTime time = timestamp == LLONG_MAX ? QDateTime() : QUaTypesConverter::uaVariantToQVariantScalar<QDateTime, UA_DateTime>(&timestamp);
+		QUaDateTime time = timestamp == LLONG_MAX ? QUaDateTime() : QUaDateTime(timestamp);
 		// get server
 		QQueue<QUaLog> logOut;
 		QUaServer* srv = QUaServer::getServerNodeContext(server);
@@ -243,7 +245,7 @@ UA_HistoryDataBackend QUaHistoryBackend::CreateUaBackend()
 			&& hasTimestamp)
 		{
 			QUaHistoryBackend::processServerLog(srv, logOut);
-			return static_cast<size_t>(time.toMSecsSinceEpoch());
+			return static_cast<size_t>(time.ticks());
 		}
 		// get match type
 		TimeMatch match;
@@ -267,7 +269,7 @@ UA_HistoryDataBackend QUaHistoryBackend::CreateUaBackend()
 			break;
 		}
 		// find timestamp
-		QDateTime outTime = srv->m_historBackend.findTimestamp(
+		QUaDateTime outTime = srv->m_historBackend.findTimestamp(
 			strNodeId,
 			time,
 			match,
@@ -280,7 +282,7 @@ UA_HistoryDataBackend QUaHistoryBackend::CreateUaBackend()
 			return LLONG_MAX;
 		}
 		// return first available timestamp as index
-		return static_cast<size_t>(outTime.toMSecsSinceEpoch());
+		return static_cast<size_t>(outTime.ticks());
 	};
 	// 7) It returns the number of elements between startIndex and endIndex including both.
 	result.resultSize = [](
@@ -296,8 +298,8 @@ UA_HistoryDataBackend QUaHistoryBackend::CreateUaBackend()
 		Q_UNUSED(sessionId);
 		Q_UNUSED(sessionContext);
 		QString   strNodeId = QUaTypesConverter::nodeIdToQString(*nodeId);
-		QDateTime timeStart = startIndex == LLONG_MAX ? QDateTime() : QDateTime::fromMSecsSinceEpoch(startIndex);
-		QDateTime timeEnd = endIndex == LLONG_MAX ? QDateTime() : QDateTime::fromMSecsSinceEpoch(endIndex);
+		QUaDateTime timeStart = startIndex == LLONG_MAX ? QUaDateTime() : QUaDateTime(static_cast<UA_DateTime>(startIndex));
+		QUaDateTime timeEnd = endIndex == LLONG_MAX ? QUaDateTime() : QUaDateTime(static_cast<UA_DateTime>(endIndex));
 		// get server
 		QQueue<QUaLog> logOut;
 		QUaServer* srv = QUaServer::getServerNodeContext(server);
@@ -334,15 +336,16 @@ UA_HistoryDataBackend QUaHistoryBackend::CreateUaBackend()
 		UA_DataValue* values) -> UA_StatusCode   // [OUT] values that have been copied from the database.
 	{
 		Q_UNUSED(hdbContext);
-		Q_UNUSED(sessionId);
 		Q_UNUSED(sessionContext);
 		Q_UNUSED(releaseContinuationPoints); // not used?
+		QElapsedTimer timer;
+		timer.start();
 		// convert inputs
 		QString   strNodeId = QUaTypesConverter::nodeIdToQString(*nodeId);
-		QDateTime timeStart = startIndex == LLONG_MAX ? QDateTime() : QDateTime::fromMSecsSinceEpoch(startIndex);
-		QDateTime timeEnd = endIndex == LLONG_MAX ? QDateTime() : QDateTime::fromMSecsSinceEpoch(endIndex);
+		QUaDateTime timeStart = startIndex == LLONG_MAX ? QUaDateTime() : QUaDateTime(static_cast<UA_DateTime>(startIndex));
+		QUaDateTime timeEnd = endIndex == LLONG_MAX ? QUaDateTime() : QUaDateTime(static_cast<UA_DateTime>(endIndex));
 		// get offset wrt to previous call
-		QDateTime timeStartOffset = timeStart;
+		QUaDateTime timeStartOffset = timeStart;
 		if (continuationPoint->length > 0)
 		{
 			Q_ASSERT(continuationPoint->length == sizeof(size_t));
@@ -350,12 +353,19 @@ UA_HistoryDataBackend QUaHistoryBackend::CreateUaBackend()
 			{
 				return UA_STATUSCODE_BADCONTINUATIONPOINTINVALID;
 			}
-			timeStartOffset = QDateTime::fromMSecsSinceEpoch(*((size_t*)(continuationPoint->data)));
+			timeStartOffset = QUaDateTime(static_cast<UA_DateTime>(*((size_t*)(continuationPoint->data))));
 			Q_ASSERT(timeStartOffset > timeStart);
 		}
 		// get server
 		QQueue<QUaLog> logOut;
 		QUaServer* srv = QUaServer::getServerNodeContext(server);
+		// admission control
+		QUaSession * session = srv->sessionById(sessionId);
+		if (session && !srv->admitRequest(session, QUaSession::Service::HistoryRead))
+		{
+			*providedValues = 0;
+			return UA_STATUSCODE_BADTOOMANYOPERATIONS;
+		}
 		// TODO : swap timestamps if reverse?
 		if (reverse)
 		{
@@ -411,14 +421,24 @@ UA_HistoryDataBackend QUaHistoryBackend::CreateUaBackend()
 				return retVal;
 			});
 		// extra requested point is to get timestamp as next continuation point
-		QDateTime timeStartOffsetNext = points.last().timestamp;
+		QUaDateTime timeStartOffsetNext = points.last().timestamp;
 		if (timeStartOffsetNext.isValid())
 		{
 			Q_ASSERT(timeStartOffsetNext > timeStartOffset);
 			outContinuationPoint->length = sizeof(size_t);
 			size_t t = sizeof(size_t);
 			outContinuationPoint->data = (UA_Byte*)UA_malloc(t);
-			*((size_t*)(outContinuationPoint->data)) = timeStartOffsetNext.toMSecsSinceEpoch();
+			*((size_t*)(outContinuationPoint->data)) = static_cast<size_t>(timeStartOffsetNext.ticks());
+		}
+		// account client history read
+		if (session)
+		{
+			quint64 bytesSent = 0;
+			for (size_t i = 0; i < valueSize; i++)
+			{
+				bytesSent += UA_calcSizeBinary(&values[i], &UA_TYPES[UA_TYPES_DATAVALUE]);
+			}
+			session->addRequest(QUaSession::Service::HistoryRead, timer.nsecsElapsed(), 0, bytesSent);
 		}
 		// success
 		return UA_STATUSCODE_GOOD;
@@ -437,7 +457,7 @@ UA_HistoryDataBackend QUaHistoryBackend::CreateUaBackend()
 		Q_UNUSED(sessionId);
 		Q_UNUSED(sessionContext);
 		QString   strNodeId = QUaTypesConverter::nodeIdToQString(*nodeId);
-		QDateTime time = index == LLONG_MAX ? QDateTime() : QDateTime::fromMSecsSinceEpoch(index);
+		QUaDateTime time = index == LLONG_MAX ? QUaDateTime() : QUaDateTime(static_cast<UA_DateTime>(index));
 		Q_ASSERT(time.isValid());
 		// get server
 		QQueue<QUaLog> logOut;
@@ -543,8 +563,8 @@ UA_HistoryDataBackend QUaHistoryBackend::CreateUaBackend()
 		Q_UNUSED(sessionId);
 		Q_UNUSED(sessionContext);
 		QString   strNodeId = QUaTypesConverter::nodeIdToQString(*nodeId);
-		QDateTime timeStart = startTimestamp == LLONG_MAX ? QDateTime() : QUaTypesConverter::uaVariantToQVariantScalar<QDateTime, UA_DateTime>(&startTimestamp);
-		QDateTime timeEnd = endTimestamp == LLONG_MAX ? QDateTime() : QUaTypesConverter::uaVariantToQVariantScalar<QDateTime, UA_DateTime>(&endTimestamp);
+		QUaDateTime timeStart = startTimestamp == LLONG_MAX ? QUaDateTime() : QUaDateTime(startTimestamp);
+		QUaDateTime timeEnd = endTimestamp == LLONG_MAX ? QUaDateTime() : QUaDateTime(endTimestamp);
 		Q_ASSERT(timeStart.isValid());
 		// get server
 		QQueue<QUaLog> logOut;
@@ -595,6 +615,8 @@ QUaHistoryBackend::QUaHistoryBackend()
 	m_findTimestamp = nullptr;
 	m_numDataPointsInRange = nullptr;
 	m_readHistoryData = nullptr;
+	m_writeHistoryEventPoint = nullptr;
+	m_readHistoryEvents = nullptr;
 }
 
 bool QUaHistoryBackend::writeHistoryData(
@@ -623,8 +645,8 @@ bool QUaHistoryBackend::updateHistoryData(
 
 bool QUaHistoryBackend::removeHistoryData(
 	const QString& strNodeId,
-	const QDateTime& timeStart,
-	const QDateTime& timeEnd,
+	const QUaDateTime& timeStart,
+	const QUaDateTime& timeEnd,
 	QQueue<QUaLog>& logOut)
 {
 	if (!m_removeHistoryData)
@@ -634,33 +656,33 @@ bool QUaHistoryBackend::removeHistoryData(
 	return m_removeHistoryData(strNodeId, timeStart, timeEnd, logOut);
 }
 
-QDateTime QUaHistoryBackend::firstTimestamp(
+QUaDateTime QUaHistoryBackend::firstTimestamp(
 	const QString& strNodeId,
 	QQueue<QUaLog>& logOut
 ) const
 {
 	if (!m_firstTimestamp)
 	{
-		return QDateTime();
+		return QUaDateTime();
 	}
 	return m_firstTimestamp(strNodeId, logOut);
 }
 
-QDateTime QUaHistoryBackend::lastTimestamp(
+QUaDateTime QUaHistoryBackend::lastTimestamp(
 	const QString& strNodeId,
 	QQueue<QUaLog>& logOut
 ) const
 {
 	if (!m_lastTimestamp)
 	{
-		return QDateTime();
+		return QUaDateTime();
 	}
 	return m_lastTimestamp(strNodeId, logOut);
 }
 
 bool QUaHistoryBackend::hasTimestamp(
 	const QString& strNodeId,
-	const QDateTime& timestamp,
+	const QUaDateTime& timestamp,
 	QQueue<QUaLog>& logOut
 ) const
 {
@@ -671,24 +693,24 @@ bool QUaHistoryBackend::hasTimestamp(
 	return m_hasTimestamp(strNodeId, timestamp, logOut);
 }
 
-QDateTime QUaHistoryBackend::findTimestamp(
+QUaDateTime QUaHistoryBackend::findTimestamp(
 	const QString& strNodeId,
-	const QDateTime& timestamp,
+	const QUaDateTime& timestamp,
 	const TimeMatch& match,
 	QQueue<QUaLog>& logOut
 ) const
 {
 	if (!m_findTimestamp)
 	{
-		return QDateTime();
+		return QUaDateTime();
 	}
 	return m_findTimestamp(strNodeId, timestamp, match, logOut);
 }
 
 quint64 QUaHistoryBackend::numDataPointsInRange(
 	const QString& strNodeId,
-	const QDateTime& timeStart,
-	const QDateTime& timeEnd,
+	const QUaDateTime& timeStart,
+	const QUaDateTime& timeEnd,
 	QQueue<QUaLog>& logOut
 ) const
 {
@@ -702,7 +724,7 @@ quint64 QUaHistoryBackend::numDataPointsInRange(
 QVector<QUaHistoryDataPoint>
 QUaHistoryBackend::readHistoryData(
 	const QString& strNodeId,
-	const QDateTime& timeStart,
+	const QUaDateTime& timeStart,
 	const quint64& numPointsToRead,
 	QQueue<QUaLog>& logOut) const
 {
@@ -718,4 +740,41 @@ QUaHistoryBackend::readHistoryData(
 	);
 }
 
+bool QUaHistoryBackend::hasEventHistory() const
+{
+	return m_writeHistoryEventPoint && m_readHistoryEvents;
+}
+
+bool QUaHistoryBackend::writeHistoryEventPoint(
+	const QUaHistoryEventPoint& eventPoint,
+	QQueue<QUaLog>& logOut)
+{
+	if (!m_writeHistoryEventPoint)
+	{
+		return false;
+	}
+	return m_writeHistoryEventPoint(eventPoint, logOut);
+}
+
+QVector<QUaHistoryEventPoint>
+QUaHistoryBackend::readHistoryEvents(
+	const QUaDateTime& timeStart,
+	const QUaDateTime& timeEnd,
+	const QUaHistoryEventFilter& filter,
+	const quint64& numEventsToRead,
+	QQueue<QUaLog>& logOut) const
+{
+	if (!m_readHistoryEvents)
+	{
+		return QVector<QUaHistoryEventPoint>();
+	}
+	return m_readHistoryEvents(
+		timeStart,
+		timeEnd,
+		filter,
+		numEventsToRead,
+		logOut
+	);
+}
+
 #endif // UA_ENABLE_HISTORIZING
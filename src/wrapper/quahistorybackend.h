@@ -3,22 +3,68 @@
 
 #ifdef UA_ENABLE_HISTORIZING
 
+#include <type_traits>
+#include <utility>
+
 #include <QVector>
 #include <QVariant>
 #include <QDateTime>
 
 #include <QUaNode>
+#include <QUaCustomDataTypes>
 
 class QUaServer;
 class QUaBaseVariable;
 
+// NOTE : timestamp keeps full UA_DateTime precision, historizers can use toDateTime
+//        where a QDateTime is needed
 struct QUaHistoryDataPoint
 {
-	QDateTime timestamp;
-	QVariant  value;
-	quint32   status;
+	QUaDateTime timestamp;
+	QVariant    value;
+	quint32     status;
+};
+
+// Event recorded when event historizing is enabled (see QUaServer::setEventHistorizing)
+// NOTE : fields holds the recorded event fields (browse name -> value),
+//        strEventType is the node id of the event type (e.g. "ns=1;i=2001")
+struct QUaHistoryEventPoint
+{
+	QUaDateTime timestamp;
+	QString     strSourceNodeId;
+	QString     strEventType;
+	quint16     severity;
+	QVariantMap fields;
+};
+
+// Filter of an event history query, applied by the historizer, empty members match any event
+// NOTE : strEventType is compared with the recorded event type node id
+struct QUaHistoryEventFilter
+{
+	QString strSourceNodeId;
+	QString strEventType;
+	quint16 minSeverity = 0;
 };
 
+// to check if historizer implements the optional events API
+template <typename T, typename = void>
+struct HasHistoryEvents
+	: std::false_type
+{};
+
+template <typename T>
+struct HasHistoryEvents<T,
+	typename std::enable_if<
+		std::is_same<decltype(std::declval<T&>().writeHistoryEventPoint(
+			std::declval<const QUaHistoryEventPoint&>(), std::declval<QQueue<QUaLog>&>())), bool>::value &&
+		std::is_same<decltype(std::declval<T&>().readHistoryEvents(
+			std::declval<const QUaDateTime&>(), std::declval<const QUaDateTime&>(),
+			std::declval<const QUaHistoryEventFilter&>(), std::declval<const quint64&>(),
+			std::declval<QQueue<QUaLog>&>())), QVector<QUaHistoryEventPoint>>::value
+	>::type>
+	: std::true_type
+{};
+
 class QUaHistoryBackend
 {
 	friend class QUaServer;
@@ -50,47 +96,66 @@ public:
 	);
 	// remove an existing node's data points within a range
 	bool removeHistoryData(
-		const QString   &strNodeId,
-		const QDateTime &timeStart,
-		const QDateTime &timeEnd,
-		QQueue<QUaLog>  &logOut
+		const QString     &strNodeId,
+		const QUaDateTime &timeStart,
+		const QUaDateTime &timeEnd,
+		QQueue<QUaLog>    &logOut
 	); 
 	// return the timestamp of the first sample available for the given node
-	QDateTime firstTimestamp(
+	QUaDateTime firstTimestamp(
 		const QString  &strNodeId,
 		QQueue<QUaLog> &logOut
 	) const;
 	// return the timestamp of the latest sample available for the given node
-	QDateTime lastTimestamp(
+	QUaDateTime lastTimestamp(
 		const QString  &strNodeId,
 		QQueue<QUaLog> &logOut
 	) const;
 	// check if given timestamp is available for the given node
 	bool hasTimestamp(
-		const QString   &strNodeId,
-		const QDateTime &timestamp,
-		QQueue<QUaLog>  &logOut
+		const QString     &strNodeId,
+		const QUaDateTime &timestamp,
+		QQueue<QUaLog>    &logOut
 	) const;
 	// find a timestamp matching the criteria for the given node
-	QDateTime findTimestamp(
-		const QString   &strNodeId,
-		const QDateTime &timestamp,
-		const TimeMatch &match,
-		QQueue<QUaLog>  &logOut
+	QUaDateTime findTimestamp(
+		const QString     &strNodeId,
+		const QUaDateTime &timestamp,
+		const TimeMatch   &match,
+		QQueue<QUaLog>    &logOut
 	) const;
 	// get the number for data points within a time range for the given node
 	quint64 numDataPointsInRange(
-		const QString   &strNodeId,
-		const QDateTime &timeStart,
-		const QDateTime &timeEnd,
-		QQueue<QUaLog>  &logOut
+		const QString     &strNodeId,
+		const QUaDateTime &timeStart,
+		const QUaDateTime &timeEnd,
+		QQueue<QUaLog>    &logOut
 	) const;
 	// return the numPointsToRead data points for the given node from the given start time
 	QVector<QUaHistoryDataPoint> readHistoryData(
-		const QString   &strNodeId,
-		const QDateTime &timeStart,
-		const quint64   &numPointsToRead,
-		QQueue<QUaLog>  &logOut
+		const QString     &strNodeId,
+		const QUaDateTime &timeStart,
+		const quint64     &numPointsToRead,
+		QQueue<QUaLog>    &logOut
+	) const;
+
+	// Optional events API
+
+	// true if historizer implements the events API below
+	bool hasEventHistory() const;
+	// write an event to backend
+	bool writeHistoryEventPoint(
+		const QUaHistoryEventPoint &eventPoint,
+		QQueue<QUaLog>             &logOut
+	);
+	// return events matching the filter within the time range ordered by time, 
+	// at most numEventsToRead (zero means no limit)
+	QVector<QUaHistoryEventPoint> readHistoryEvents(
+		const QUaDateTime           &timeStart,
+		const QUaDateTime           &timeEnd,
+		const QUaHistoryEventFilter &filter,
+		const quint64               &numEventsToRead,
+		QQueue<QUaLog>              &logOut
 	) const;
 
 private:
@@ -107,13 +172,20 @@ private:
 	// lambdas to capture historizer
 	std::function<bool(const QString&, const QUaHistoryDataPoint&, QQueue<QUaLog>&)> m_writeHistoryData;
 	std::function<bool(const QString&, const QUaHistoryDataPoint&, QQueue<QUaLog>&)> m_updateHistoryData;
-	std::function<bool(const QString&, const QDateTime&, const QDateTime&, QQueue<QUaLog>&)> m_removeHistoryData;
-	std::function<QDateTime(const QString&, QQueue<QUaLog>&)> m_firstTimestamp;
-	std::function<QDateTime(const QString&, QQueue<QUaLog>&)> m_lastTimestamp;
-	std::function<bool(const QString&, const QDateTime&, QQueue<QUaLog>&)> m_hasTimestamp;
-	std::function<QDateTime(const QString&, const QDateTime&, const TimeMatch&, QQueue<QUaLog>&)> m_findTimestamp;
-	std::function<quint64(const QString&, const QDateTime&, const QDateTime&, QQueue<QUaLog>&)> m_numDataPointsInRange;
-	std::function<QVector<QUaHistoryDataPoint>(const QString&, const QDateTime&, const quint64&, QQueue<QUaLog>&)> m_readHistoryData;
+	std::function<bool(const QString&, const QUaDateTime&, const QUaDateTime&, QQueue<QUaLog>&)> m_removeHistoryData;
+	std::function<QUaDateTime(const QString&, QQueue<QUaLog>&)> m_firstTimestamp;
+	std::function<QUaDateTime(const QString&, QQueue<QUaLog>&)> m_lastTimestamp;
+	std::function<bool(const QString&, const QUaDateTime&, QQueue<QUaLog>&)> m_hasTimestamp;
+	std::function<QUaDateTime(const QString&, const QUaDateTime&, const TimeMatch&, QQueue<QUaLog>&)> m_findTimestamp;
+	std::function<quint64(const QString&, const QUaDateTime&, const QUaDateTime&, QQueue<QUaLog>&)> m_numDataPointsInRange;
+	std::function<QVector<QUaHistoryDataPoint>(const QString&, const QUaDateTime&, const quint64&, QQueue<QUaLog>&)> m_readHistoryData;
+	std::function<bool(const QUaHistoryEventPoint&, QQueue<QUaLog>&)> m_writeHistoryEventPoint;
+	std::function<QVector<QUaHistoryEventPoint>(const QUaDateTime&, const QUaDateTime&, const QUaHistoryEventFilter&, const quint64&, QQueue<QUaLog>&)> m_readHistoryEvents;
+
+	template<typename T>
+	void setEventHistorizer(T& historizer, std::true_type);
+	template<typename T>
+	void setEventHistorizer(T& historizer, std::false_type);
 
 
 };
@@ -147,10 +219,10 @@ inline void QUaHistoryBackend::setHistorizer(T& historizer)
 	};
 	// removeHistoryData
 	m_removeHistoryData = [&historizer](
-		const QString   &strNodeId,
-		const QDateTime &timeStart,
-		const QDateTime &timeEnd,
-		QQueue<QUaLog>  &logOut
+		const QString     &strNodeId,
+		const QUaDateTime &timeStart,
+		const QUaDateTime &timeEnd,
+		QQueue<QUaLog>    &logOut
 		) -> bool {
 			return historizer.removeHistoryData(
 				strNodeId,
@@ -163,7 +235,7 @@ inline void QUaHistoryBackend::setHistorizer(T& historizer)
 	m_firstTimestamp = [&historizer](
 		const QString  &strNodeId,
 		QQueue<QUaLog> &logOut
-		) -> QDateTime {
+		) -> QUaDateTime {
 			return historizer.firstTimestamp(
 				strNodeId,
 				logOut
@@ -173,7 +245,7 @@ inline void QUaHistoryBackend::setHistorizer(T& historizer)
 	m_lastTimestamp = [&historizer](
 		const QString  &strNodeId,
 		QQueue<QUaLog> &logOut
-		) -> QDateTime {
+		) -> QUaDateTime {
 			return historizer.lastTimestamp(
 				strNodeId,
 				logOut
@@ -181,9 +253,9 @@ inline void QUaHistoryBackend::setHistorizer(T& historizer)
 	};
 	// hasTimestamp
 	m_hasTimestamp = [&historizer](
-		const QString   &strNodeId,
-		const QDateTime &timestamp,
-		QQueue<QUaLog>  &logOut
+		const QString     &strNodeId,
+		const QUaDateTime &timestamp,
+		QQueue<QUaLog>    &logOut
 		) -> bool {
 			return historizer.hasTimestamp(
 				strNodeId,
@@ -193,11 +265,11 @@ inline void QUaHistoryBackend::setHistorizer(T& historizer)
 	};
 	// findTimestamp
 	m_findTimestamp = [&historizer](
-		const QString   &strNodeId,
-		const QDateTime &timestamp,
-		const TimeMatch &match,
-		QQueue<QUaLog>  &logOut
-		) -> QDateTime {
+		const QString     &strNodeId,
+		const QUaDateTime &timestamp,
+		const TimeMatch   &match,
+		QQueue<QUaLog>    &logOut
+		) -> QUaDateTime {
 			return historizer.findTimestamp(
 				strNodeId,
 				timestamp,
@@ -207,10 +279,10 @@ inline void QUaHistoryBackend::setHistorizer(T& historizer)
 	};
 	// numDataPointsInRange
 	m_numDataPointsInRange = [&historizer](
-		const QString   &strNodeId, 
-		const QDateTime &timeStart, 
-		const QDateTime &timeEnd,
-		QQueue<QUaLog>  &logOut
+		const QString     &strNodeId, 
+		const QUaDateTime &timeStart, 
+		const QUaDateTime &timeEnd,
+		QQueue<QUaLog>    &logOut
 		) -> quint64 {
 			return historizer.numDataPointsInRange(
 				strNodeId,
@@ -221,10 +293,10 @@ inline void QUaHistoryBackend::setHistorizer(T& historizer)
 	};
 	// readHistoryData
 	m_readHistoryData = [&historizer](
-		const QString   &strNodeId, 
-		const QDateTime &timeStart, 
-		const quint64   &numPointsToRead,
-		QQueue<QUaLog>  &logOut
+		const QString     &strNodeId, 
+		const QUaDateTime &timeStart, 
+		const quint64     &numPointsToRead,
+		QQueue<QUaLog>    &logOut
 		) -> QVector<QUaHistoryDataPoint>{
 			return historizer.readHistoryData(
 				strNodeId,
@@ -233,6 +305,47 @@ inline void QUaHistoryBackend::setHistorizer(T& historizer)
 				logOut
 			);
 	};
+	// optional events API
+	this->setEventHistorizer(historizer, HasHistoryEvents<T>());
+}
+
+template<typename T>
+inline void QUaHistoryBackend::setEventHistorizer(T& historizer, std::true_type)
+{
+	// writeHistoryEventPoint
+	m_writeHistoryEventPoint = [&historizer](
+		const QUaHistoryEventPoint &eventPoint,
+		QQueue<QUaLog>             &logOut
+		) -> bool {
+			return historizer.writeHistoryEventPoint(
+				eventPoint,
+				logOut
+			);
+	};
+	// readHistoryEvents
+	m_readHistoryEvents = [&historizer](
+		const QUaDateTime           &timeStart,
+		const QUaDateTime           &timeEnd,
+		const QUaHistoryEventFilter &filter,
+		const quint64               &numEventsToRead,
+		QQueue<QUaLog>              &logOut
+		) -> QVector<QUaHistoryEventPoint> {
+			return historizer.readHistoryEvents(
+				timeStart,
+				timeEnd,
+				filter,
+				numEventsToRead,
+				logOut
+			);
+	};
+}
+
+template<typename T>
+inline void QUaHistoryBackend::setEventHistorizer(T& historizer, std::false_type)
+{
+	Q_UNUSED(historizer);
+	m_writeHistoryEventPoint = nullptr;
+	m_readHistoryEvents      = nullptr;
 }
 
 #endif // UA_ENABLE_HISTORIZING
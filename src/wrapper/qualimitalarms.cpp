@@ -0,0 +1,306 @@
+#include "qualimitalarms.h"
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
+#include <cmath>
+
+#include <QUaServer>
+
+#define QUA_LIMIT_ALARMS_SCAN_MS 500
+
+// reads numeric scalar without going through QVariant
+static bool uaNumericToDouble(const UA_Variant &uaVariant, double &value)
+{
+	if (!uaVariant.type || !UA_Variant_isScalar(&uaVariant) || 
+		uaVariant.type->typeIndex >= UA_TYPES_COUNT ||
+		uaVariant.type != &UA_TYPES[uaVariant.type->typeIndex])
+	{
+		return false;
+	}
+	switch (uaVariant.type->typeIndex)
+	{
+	case UA_TYPES_BOOLEAN: value = *static_cast<UA_Boolean*>(uaVariant.data) ? 1.0 : 0.0; return true;
+	case UA_TYPES_SBYTE  : value = *static_cast<UA_SByte  *>(uaVariant.data); return true;
+	case UA_TYPES_BYTE   : value = *static_cast<UA_Byte   *>(uaVariant.data); return true;
+	case UA_TYPES_INT16  : value = *static_cast<UA_Int16  *>(uaVariant.data); return true;
+	case UA_TYPES_UINT16 : value = *static_cast<UA_UInt16 *>(uaVariant.data); return true;
+	case UA_TYPES_INT32  : value = *static_cast<UA_Int32  *>(uaVariant.data); return true;
+	case UA_TYPES_UINT32 : value = *static_cast<UA_UInt32 *>(uaVariant.data); return true;
+	case UA_TYPES_INT64  : value = static_cast<double>(*static_cast<UA_Int64 *>(uaVariant.data)); return true;
+	case UA_TYPES_UINT64 : value = static_cast<double>(*static_cast<UA_UInt64*>(uaVariant.data)); return true;
+	case UA_TYPES_FLOAT  : value = *static_cast<UA_Float  *>(uaVariant.data); return true;
+	case UA_TYPES_DOUBLE : value = *static_cast<UA_Double *>(uaVariant.data); return true;
+	default: return false;
+	}
+}
+
+static QString limitStateName(const quint8 &limitState)
+{
+	switch (limitState)
+	{
+	case QUaLimitAlarms::LowLow  : return QStringLiteral("LowLow");
+	case QUaLimitAlarms::Low     : return QStringLiteral("Low");
+	case QUaLimitAlarms::High    : return QStringLiteral("High");
+	case QUaLimitAlarms::HighHigh: return QStringLiteral("HighHigh");
+	default: return QString();
+	}
+}
+
+QUaLimitAlarms::QUaLimitAlarms(QUaServer *server)
+	: QUaBaseObject(server)
+{
+	QObject::connect(&m_scanTimer, &QTimer::timeout, this, &QUaLimitAlarms::scan);
+	m_scanTimer.start(QUA_LIMIT_ALARMS_SCAN_MS);
+}
+
+bool QUaLimitAlarms::addAlarm(const QString & strConditionName, QUaBaseVariable * variable, const QUaLimits & limits, const quint16 & severity/* = 500*/)
+{
+	Q_CHECK_PTR(variable);
+	if (!variable)
+	{
+		return false;
+	}
+	int index = m_hashIndexes.value(strConditionName, -1);
+	if (index < 0)
+	{
+		index = m_variables.count();
+		m_hashIndexes.insert(strConditionName, index);
+		m_names      .append(strConditionName);
+		m_variables  .append(variable);
+		m_lowLow     .append(0.0);
+		m_low        .append(0.0);
+		m_high       .append(0.0);
+		m_highHigh   .append(0.0);
+		m_severities .append(0);
+		m_states     .append(Normal | AckedFlag | ConfirmedFlag);
+		m_values     .append(std::nan(""));
+		// remove alarm when input is deleted, disconnected in removeAlarm
+		m_connections.append(QObject::connect(variable, &QObject::destroyed, this,
+		[this, strConditionName]() {
+			this->removeAlarm(strConditionName);
+		}));
+	}
+	else if (m_variables[index] != variable)
+	{
+		Q_ASSERT_X(false, "QUaLimitAlarms::addAlarm", "Condition name already used for another variable.");
+		return false;
+	}
+	m_lowLow    [index] = limits.lowLow;
+	m_low       [index] = limits.low;
+	m_high      [index] = limits.high;
+	m_highHigh  [index] = limits.highHigh;
+	m_severities[index] = severity;
+	return true;
+}
+
+void QUaLimitAlarms::removeAlarm(const QString & strConditionName)
+{
+	int index = m_hashIndexes.value(strConditionName, -1);
+	if (index < 0)
+	{
+		return;
+	}
+	// move last into removed slot to keep arrays packed
+	int last = m_variables.count() - 1;
+	QObject::disconnect(m_connections[index]);
+	if (index != last)
+	{
+		m_names      [index] = m_names      [last];
+		m_variables  [index] = m_variables  [last];
+		m_connections[index] = m_connections[last];
+		m_lowLow     [index] = m_lowLow     [last];
+		m_low        [index] = m_low        [last];
+		m_high       [index] = m_high       [last];
+		m_highHigh   [index] = m_highHigh   [last];
+		m_severities [index] = m_severities [last];
+		m_states     [index] = m_states     [last];
+		m_values     [index] = m_values     [last];
+		m_hashIndexes[m_names[index]] = index;
+	}
+	m_names      .removeLast();
+	m_variables  .removeLast();
+	m_connections.removeLast();
+	m_lowLow     .removeLast();
+	m_low        .removeLast();
+	m_high       .removeLast();
+	m_highHigh   .removeLast();
+	m_severities .removeLast();
+	m_states     .removeLast();
+	m_values     .removeLast();
+	m_hashIndexes.remove(strConditionName);
+}
+
+int QUaLimitAlarms::alarmCount() const
+{
+	return m_variables.count();
+}
+
+QUaLimitAlarms::LimitState QUaLimitAlarms::limitState(const QString & strConditionName) const
+{
+	int index = m_hashIndexes.value(strConditionName, -1);
+	return index < 0 ? Normal : static_cast<LimitState>(m_states[index] & LimitMask);
+}
+
+bool QUaLimitAlarms::isActive(const QString & strConditionName) const
+{
+	int index = m_hashIndexes.value(strConditionName, -1);
+	return index >= 0 && (m_states[index] & ActiveFlag);
+}
+
+bool QUaLimitAlarms::isAcked(const QString & strConditionName) const
+{
+	int index = m_hashIndexes.value(strConditionName, -1);
+	return index >= 0 && (m_states[index] & AckedFlag);
+}
+
+bool QUaLimitAlarms::isConfirmed(const QString & strConditionName) const
+{
+	int index = m_hashIndexes.value(strConditionName, -1);
+	return index >= 0 && (m_states[index] & ConfirmedFlag);
+}
+
+quint32 QUaLimitAlarms::scanInterval() const
+{
+	return m_scanTimer.isActive() ? static_cast<quint32>(m_scanTimer.interval()) : 0;
+}
+
+void QUaLimitAlarms::setScanInterval(const quint32 & intervalMs)
+{
+	if (intervalMs == 0)
+	{
+		m_scanTimer.stop();
+		return;
+	}
+	m_scanTimer.start(static_cast<int>(intervalMs));
+}
+
+void QUaLimitAlarms::scan()
+{
+	const int count = m_variables.count();
+	if (count == 0)
+	{
+		return;
+	}
+	m_scanValues.resize(count);
+	m_scanValid .resize(count);
+	m_scanLimits.resize(count);
+	// gather input values
+	UA_Variant uaValue;
+	for (int i = 0; i < count; i++)
+	{
+		auto st = m_variables[i]->readValueInternal(uaValue);
+		m_scanValid[i] = st == UA_STATUSCODE_GOOD && uaNumericToDouble(uaValue, m_scanValues[i]);
+		if (st == UA_STATUSCODE_GOOD)
+		{
+			UA_Variant_clear(&uaValue);
+		}
+	}
+	// evaluate limits, branchless so the loop can be vectorised
+	// NOTE : NaN limits never compare true, so they are disabled
+	const double * values   = m_scanValues.constData();
+	const quint8 * valid    = m_scanValid .constData();
+	const double * lowLow   = m_lowLow    .constData();
+	const double * low      = m_low       .constData();
+	const double * high     = m_high      .constData();
+	const double * highHigh = m_highHigh  .constData();
+	quint8       * limits   = m_scanLimits.data();
+	quint8       * states   = m_states    .data();
+	for (int i = 0; i < count; i++)
+	{
+		const double v  = values[i];
+		const quint8 hh = v >= highHigh[i];
+		const quint8 h  = !hh & (v >= high[i]);
+		const quint8 ll = !hh & !h & (v <= lowLow[i]);
+		const quint8 l  = !hh & !h & !ll & (v <= low[i]);
+		const quint8 newLimit = static_cast<quint8>(hh * HighHigh + h * High + ll * LowLow + l * Low);
+		// keep old limit if value could not be read
+		limits[i] = valid[i] ? newLimit : (states[i] & LimitMask);
+	}
+	// collect transitions
+	m_transitions.clear();
+	for (int i = 0; i < count; i++)
+	{
+		if (limits[i] != (states[i] & LimitMask))
+		{
+			m_transitions.append(i);
+		}
+	}
+	// apply transitions and notify
+	for (int i : m_transitions)
+	{
+		const quint8 newLimit = limits[i];
+		quint8 &state = states[i];
+		if (newLimit != Normal)
+		{
+			// new or different limit must be acknowledged again
+			state = newLimit | ActiveFlag;
+		}
+		else
+		{
+			state = (state & (AckedFlag | ConfirmedFlag)) | Normal;
+		}
+		m_values[i] = values[i];
+		this->triggerAlarmEvent(i, newLimit != Normal ?
+			QString("%1 limit exceeded.").arg(limitStateName(newLimit)) :
+			QString("Back to normal."));
+	}
+}
+
+bool QUaLimitAlarms::acknowledge(const QString & conditionName, const QString & comment)
+{
+	int index = m_hashIndexes.value(conditionName, -1);
+	if (index < 0 || (m_states[index] & AckedFlag))
+	{
+		return false;
+	}
+	m_states[index] |= AckedFlag;
+	this->triggerAlarmEvent(index, comment.isEmpty() ? QString("Acknowledged.") : QString("Acknowledged : %1").arg(comment));
+	return true;
+}
+
+bool QUaLimitAlarms::confirm(const QString & conditionName, const QString & comment)
+{
+	int index = m_hashIndexes.value(conditionName, -1);
+	if (index < 0 || !(m_states[index] & AckedFlag) || (m_states[index] & ConfirmedFlag))
+	{
+		return false;
+	}
+	m_states[index] |= ConfirmedFlag;
+	this->triggerAlarmEvent(index, comment.isEmpty() ? QString("Confirmed.") : QString("Confirmed : %1").arg(comment));
+	return true;
+}
+
+void QUaLimitAlarms::conditionRefresh()
+{
+	for (int i = 0; i < m_states.count(); i++)
+	{
+		if (!QUaLimitAlarms::retained(m_states[i]))
+		{
+			continue;
+		}
+		this->triggerAlarmEvent(i, QString("Refresh."));
+	}
+}
+
+bool QUaLimitAlarms::retained(const quint8 & state)
+{
+	return (state & ActiveFlag) || !(state & AckedFlag) || !(state & ConfirmedFlag);
+}
+
+void QUaLimitAlarms::triggerAlarmEvent(const int & index, const QString & strMessage)
+{
+	const quint8 state = m_states[index];
+	QVariantMap fields;
+	fields["conditionName" ] = m_names[index];
+	fields["activeState"   ] = (state & ActiveFlag) != 0;
+	fields["ackedState"    ] = (state & AckedFlag) != 0;
+	fields["confirmedState"] = (state & ConfirmedFlag) != 0;
+	fields["retain"        ] = QUaLimitAlarms::retained(state);
+	fields["limitState"    ] = limitStateName(state & LimitMask);
+	fields["inputValue"    ] = m_values[index];
+	fields["Severity"      ] = m_severities[index];
+	fields["Message"       ] = strMessage;
+	m_qUaServer->triggerEvent<QUaAlarmConditionEvent>(m_variables[index], fields);
+}
+
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
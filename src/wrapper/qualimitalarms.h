@@ -0,0 +1,112 @@
+#ifndef QUALIMITALARMS_H
+#define QUALIMITALARMS_H
+
+#include <QUaBaseObject>
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
+#include <QTimer>
+#include <QUaAlarmConditionEvent>
+
+class QUaBaseVariable;
+
+// Limits of a limit alarm, NaN disables a limit
+struct QUaLimits
+{
+	double lowLow;
+	double low;
+	double high;
+	double highHigh;
+};
+
+/*
+Part 9 - 5.8.17 ExclusiveLimitAlarmType (subset)
+Container of limit alarms over numeric variables. Limits are evaluated in batches, the
+values are read directly from the address space on each scan (no valueChanged signals) and
+the state of all alarms is kept in flat arrays. Scans read the stored value without calling
+read callbacks, and memory bound data sources in place; only data sources bound to an
+accessor (setDataSource with a read callback) are evaluated on every scan.
+A QUaAlarmConditionEvent is triggered from the input variable only when the state of an
+alarm changes.
+Clients acknowledge and confirm alarms by condition name through the acknowledge and
+confirm methods, conditionRefresh triggers again the events of all retained alarms.
+*/
+
+class QUaLimitAlarms : public QUaBaseObject
+{
+    Q_OBJECT
+
+public:
+	Q_INVOKABLE explicit QUaLimitAlarms(QUaServer *server);
+
+	enum LimitState
+	{
+		Normal   = 0,
+		LowLow   = 1,
+		Low      = 2,
+		High     = 3,
+		HighHigh = 4
+	};
+
+	// Limit Alarms API
+
+	// adds an alarm over a numeric variable, updates limits and severity if name already exists
+	bool addAlarm(const QString &strConditionName, QUaBaseVariable * variable, const QUaLimits &limits, const quint16 &severity = 500);
+	void removeAlarm(const QString &strConditionName);
+	int  alarmCount() const;
+
+	LimitState limitState (const QString &strConditionName) const;
+	bool       isActive   (const QString &strConditionName) const;
+	bool       isAcked    (const QString &strConditionName) const;
+	bool       isConfirmed(const QString &strConditionName) const;
+
+	// period of the automatic scan, zero disables it (then scan() must be called)
+	quint32 scanInterval() const;
+	void    setScanInterval(const quint32 &intervalMs);
+
+	// evaluates the limits of all alarms
+	void scan();
+
+	// OPC UA methods
+
+	// false if condition does not exist or is already acknowledged
+	Q_INVOKABLE bool acknowledge(const QString &conditionName, const QString &comment);
+	// false if condition does not exist, is not acknowledged or is already confirmed
+	Q_INVOKABLE bool confirm(const QString &conditionName, const QString &comment);
+	// triggers the events of all retained alarms
+	Q_INVOKABLE void conditionRefresh();
+
+private:
+	// alarm state as struct of arrays, indexed by alarm
+	QVector<QUaBaseVariable*>        m_variables;
+	QVector<QMetaObject::Connection> m_connections;
+	QVector<double>                  m_lowLow;
+	QVector<double>                  m_low;
+	QVector<double>                  m_high;
+	QVector<double>                  m_highHigh;
+	QVector<quint16>                 m_severities;
+	// limit state in the low bits, then active, acked and confirmed flags
+	QVector<quint8>                  m_states;
+	QVector<double>                  m_values;
+	QStringList                      m_names;
+	QHash<QString, int>              m_hashIndexes;
+	// scratch buffers reused by scan
+	QVector<double>                  m_scanValues;
+	QVector<quint8>                  m_scanValid;
+	QVector<quint8>                  m_scanLimits;
+	QVector<int>                     m_transitions;
+	QTimer                           m_scanTimer;
+
+	static const quint8 LimitMask     = 0x07;
+	static const quint8 ActiveFlag    = 0x08;
+	static const quint8 AckedFlag     = 0x10;
+	static const quint8 ConfirmedFlag = 0x20;
+
+	static bool retained(const quint8 &state);
+	void triggerAlarmEvent(const int &index, const QString &strMessage);
+
+};
+
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
+#endif // QUALIMITALARMS_H
@@ -0,0 +1,34 @@
+#include "quamethodcompletedevent.h"
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
+QUaMethodCompletedEvent::QUaMethodCompletedEvent(QUaServer *server)
+	: QUaBaseEvent(server)
+{
+	m_callHandle = this->findChild<QUaProperty*>("callHandle");
+	m_methodName = this->findChild<QUaProperty*>("methodName");
+	m_statusCode = this->findChild<QUaProperty*>("statusCode");
+	m_result     = this->findChild<QUaProperty*>("result");
+}
+
+QUaProperty * QUaMethodCompletedEvent::callHandle()
+{
+	return m_callHandle;
+}
+
+QUaProperty * QUaMethodCompletedEvent::methodName()
+{
+	return m_methodName;
+}
+
+QUaProperty * QUaMethodCompletedEvent::statusCode()
+{
+	return m_statusCode;
+}
+
+QUaProperty * QUaMethodCompletedEvent::result()
+{
+	return m_result;
+}
+
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
@@ -0,0 +1,46 @@
+#ifndef QUAMETHODCOMPLETEDEVENT_H
+#define QUAMETHODCOMPLETEDEVENT_H
+
+#include <QUaBaseEvent>
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
+/*
+Event triggered by QUaServer when an asynchronous method (QUaBaseObject::addMethodAsync) 
+finishes, fails or times out. It is triggered from the object the method belongs to, clients
+match it with the call through the CallHandle the Call returned.
+*/
+
+class QUaMethodCompletedEvent : public QUaBaseEvent
+{
+    Q_OBJECT
+
+	// UInt32 : handle returned as output argument by the Call that started the method
+	Q_PROPERTY(QUaProperty * callHandle READ callHandle)
+	// String : browse name of the method
+	Q_PROPERTY(QUaProperty * methodName READ methodName)
+	// UInt32 : Good, BadTimeout if not finished in time or BadInternalError if cancelled
+	Q_PROPERTY(QUaProperty * statusCode READ statusCode)
+	// BaseDataType : value of the finished future, empty for void methods or on error
+	Q_PROPERTY(QUaProperty * result     READ result    )
+
+public:
+	Q_INVOKABLE explicit QUaMethodCompletedEvent(QUaServer *server);
+
+	QUaProperty * callHandle();
+	QUaProperty * methodName();
+	QUaProperty * statusCode();
+	QUaProperty * result    ();
+
+private:
+	// cached on construction
+	QUaProperty * m_callHandle;
+	QUaProperty * m_methodName;
+	QUaProperty * m_statusCode;
+	QUaProperty * m_result;
+
+};
+
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
+#endif // QUAMETHODCOMPLETEDEVENT_H
@@ -1,5 +1,8 @@
 #include "quanode.h"
 
+#include <algorithm>
+#include <QChildEvent>
+
 #include <QUaServer>
 #include <QUaProperty>
 #include <QUaBaseDataVariable>
@@ -25,6 +28,11 @@ QUaNode::QUaNode(QUaServer *server)
 	// so we need to also set the context again in QUaServer::uaConstructor
 	// set server instance
 	this->m_qUaServer = server;
+	// no role rules, masks computed on first access
+	std::fill(m_roleGrants, m_roleGrants + QUA_PERMISSIONS_COUNT, 0);
+	std::fill(m_roleDenies, m_roleDenies + QUA_PERMISSIONS_COUNT, 0);
+	std::fill(m_roleMasks , m_roleMasks  + QUA_PERMISSIONS_COUNT, 0);
+	m_rolesVersion = 0;
 	// set c++ instance as context
 	UA_Server_setNodeContext(server->m_server, nodeId, (void*)this);
 	// set node id to c++ instance
@@ -132,6 +140,10 @@ QUaNode::QUaNode(QUaServer *server)
 
 QUaNode::~QUaNode()
 {
+	// cached permissions are keyed by node
+	this->clearPermissionsCache();
+	// stop tracking role rules of this node
+	m_qUaServer->m_roleRuleNodes.remove(this);
 	// check if node id has been already removed from node store
 	// i.e. child of deleted parent node, or ...
 	UA_NodeId outNodeId;
@@ -140,11 +152,24 @@ QUaNode::~QUaNode()
 	{
 		// cleanup
 		UA_NodeId_clear(&outNodeId);
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+		// parent deleted first and dropped its addition, drop the changes affecting this node
+		m_qUaServer->cancelChanges(this->nodeId());
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+		QUaTypesConverter::removeNodeIdFromCache(m_nodeId);
 		return;
 	}
 	Q_ASSERT(UA_NodeId_equal(&m_nodeId, &outNodeId));
 	// cleanup
 	UA_NodeId_clear(&outNodeId);
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	// needed to cancel out pending reference added change
+	QString strNodeId = this->nodeId();
+	// changes affecting the node itself are gone with it
+	m_qUaServer->cancelChanges(strNodeId);
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	// node id string no longer needed
+	QUaTypesConverter::removeNodeIdFromCache(m_nodeId);
 	// remove context, so we avoid double deleting in ua destructor when called
 	st = UA_Server_setNodeContext(m_qUaServer->m_server, m_nodeId, nullptr);
 	Q_ASSERT(st == UA_STATUSCODE_GOOD);
@@ -161,11 +186,11 @@ QUaNode::~QUaNode()
 		return;
 	}
 	// add reference deleted change to buffer
-	m_qUaServer->addChange({
-		parent->nodeId(),
-		parent->typeDefinitionNodeId(),
+	m_qUaServer->addChange(
+		parent,
+		strNodeId,
 		QUaChangeVerb::ReferenceDeleted // UaExpert does not recognize QUaChangeVerb::NodeAdded
-	});	
+	);
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 }
 
@@ -318,7 +343,7 @@ QString QUaNode::browseName() const
 	Q_UNUSED(st);
 	// populate return value
 	// NOTE : ignore Namespace index outBrowseName.namespaceIndex
-	QString strBrowseName = QUaTypesConverter::uaStringToQString(outBrowseName.name);
+	QString strBrowseName = QUaTypesConverter::uaQualifiedNameToQString(outBrowseName);
 	// cleanup
 	UA_QualifiedName_clear(&outBrowseName);
 	return strBrowseName;
@@ -329,9 +354,8 @@ void QUaNode::setBrowseName(const QString & browseName)
 	Q_CHECK_PTR(m_qUaServer);
 	Q_ASSERT(!UA_NodeId_isNull(&m_nodeId));
 	// convert to UA_QualifiedName
-	UA_QualifiedName bName;
-	bName.namespaceIndex = 1; // NOTE : force default namespace index 1
-	bName.name           = QUaTypesConverter::uaStringFromQString(browseName);
+	// NOTE : force default namespace index 1
+	UA_QualifiedName bName = QUaTypesConverter::uaQualifiedNameFromQString(browseName);
 	// set value
 	auto st = UA_Server_writeBrowseName(m_qUaServer->m_server, m_nodeId, bName);
 	Q_ASSERT(st == UA_STATUSCODE_GOOD);
@@ -447,7 +471,7 @@ QString QUaNode::typeDefinitionBrowseName() const
 	Q_UNUSED(st);
 	// populate return value
 	// NOTE : ignore Namespace index outBrowseName.namespaceIndex
-	QString strBrowseName = QUaTypesConverter::uaStringToQString(outBrowseName.name);
+	QString strBrowseName = QUaTypesConverter::uaQualifiedNameToQString(outBrowseName);
 	// cleanup
 	UA_QualifiedName_clear(&outBrowseName);
 	return strBrowseName;
@@ -725,6 +749,44 @@ bool QUaNode::userExecutableInternal(const QString & strUserName)
 	return this->userExecutable(strUserName);
 }
 
+void QUaNode::childEvent(QChildEvent * event)
+{
+	QObject::childEvent(event);
+	// NOTE : only sent on removal when child is re-parented or deleted, not on creation,
+	//        permissions and role masks are inherited so the whole subtree is affected
+	if (!event->removed())
+	{
+		return;
+	}
+	Q_CHECK_PTR(m_qUaServer);
+	m_qUaServer->rolesChanged();
+}
+
+void QUaNode::clearPermissionsCache()
+{
+	Q_CHECK_PTR(m_qUaServer);
+	m_qUaServer->clearPermissionsCache();
+}
+
+const quint64 * QUaNode::roleMasks()
+{
+	Q_CHECK_PTR(m_qUaServer);
+	if (m_rolesVersion == m_qUaServer->m_rolesVersion)
+	{
+		return m_roleMasks;
+	}
+	// inherit from parent, then apply own rules
+	QUaNode * parent = qobject_cast<QUaNode*>(this->parent());
+	const quint64 * parentMasks = parent ? parent->roleMasks() : nullptr;
+	for (int i = 0; i < QUA_PERMISSIONS_COUNT; i++)
+	{
+		quint64 inherited = parentMasks ? parentMasks[i] : 0;
+		m_roleMasks[i] = (inherited | m_roleGrants[i]) & ~m_roleDenies[i];
+	}
+	m_rolesVersion = m_qUaServer->m_rolesVersion;
+	return m_roleMasks;
+}
+
 const QMap<QString, QVariant> QUaNode::serializeAttrs() const
 {
 	QMap<QString, QVariant> retMap;
@@ -1023,7 +1085,7 @@ QString QUaNode::getBrowseName(const UA_NodeId & nodeId, UA_Server * server)
 	Q_ASSERT(st == UA_STATUSCODE_GOOD);
 	Q_UNUSED(st);
 	// NOTE : ignore Namespace index outBrowseName.namespaceIndex
-	QString strBrowseName = QUaTypesConverter::uaStringToQString(outBrowseName.name);
+	QString strBrowseName = QUaTypesConverter::uaQualifiedNameToQString(outBrowseName);
 	UA_QualifiedName_clear(&outBrowseName);
 	return strBrowseName;
 }
@@ -132,9 +132,18 @@ namespace QUa
 		Application
 	};
 	Q_ENUM_NS(LogCategory)
+
+	// Part 4 - 7.17.2 : DataChangeFilter
+	enum class DeadbandType {
+		None     = UA_DEADBANDTYPE_NONE,
+		Absolute = UA_DEADBANDTYPE_ABSOLUTE,
+		Percent  = UA_DEADBANDTYPE_PERCENT
+	};
+	Q_ENUM_NS(DeadbandType)
 }
-typedef QUa::LogLevel    QUaLogLevel;
-typedef QUa::LogCategory QUaLogCategory;
+typedef QUa::LogLevel     QUaLogLevel;
+typedef QUa::LogCategory  QUaLogCategory;
+typedef QUa::DeadbandType QUaDeadbandType;
 
 struct QUaLog
 {
@@ -299,12 +308,40 @@ union QUaAccessLevel
 	};
 };
 
+// maximum number of roles in QUaServer's Roles API (one bit per role)
+#define QUA_MAX_ROLES 64
+
+union QUaPermissions
+{
+	struct bit_map {
+		bool bRead    : 1; // read values and attributes
+		bool bWrite   : 1; // write values and attributes
+		bool bBrowse  : 1; // browse node
+		bool bExecute : 1; // execute methods
+	} bits;
+	quint8 intValue;
+	// constructors
+	QUaPermissions()
+	{
+		// nothing granted by default
+		intValue = 0;
+	};
+	QUaPermissions(const quint8& value)
+	{
+		intValue = value;
+	};
+};
+
+// number of permission bits in QUaPermissions
+#define QUA_PERMISSIONS_COUNT 4
+
 class QUaNode : public QObject
 {
 	friend class QUaServer;
 	friend class QUaBaseObject;
 	friend class QUaBaseVariable;
 	friend class QUaBaseEvent;
+	friend class QUaLimitAlarms;
 
 	Q_OBJECT
 
@@ -491,6 +528,8 @@ signals:
 protected:
 	// to be able to reuse methods in subclasses
 	QUaServer* m_qUaServer;
+	// invalidates cached permissions when a child is re-parented
+	void childEvent(QChildEvent *event) override;
 
 private:
 	// INSTANCE NodeId
@@ -518,6 +557,10 @@ private:
 	QUaWriteMask   userWriteMaskInternal(const QString& strUserName);
 	QUaAccessLevel userAccessLevelInternal(const QString& strUserName);
 	bool           userExecutableInternal(const QString& strUserName);
+	// permissions of this node and its descendants might have changed
+	void clearPermissionsCache();
+	// role masks of this node (one per permission, bit per role), computed from parent if stale
+	const quint64 * roleMasks();
 
 	// Serialization API
 	const QMap<QString, QVariant>    serializeAttrs() const;
@@ -570,6 +613,11 @@ private:
 	std::function<QUaWriteMask(const QString&)> m_userWriteMaskCallback;
 	std::function<QUaAccessLevel(const QString&)> m_userAccessLevelCallback;
 	std::function<bool(const QString&)> m_userExecutableCallback;
+	// role rules of this node and effective role masks, indexed by permission bit (see QUaServer Roles API)
+	quint64 m_roleGrants[QUA_PERMISSIONS_COUNT];
+	quint64 m_roleDenies[QUA_PERMISSIONS_COUNT];
+	quint64 m_roleMasks [QUA_PERMISSIONS_COUNT];
+	quint32 m_rolesVersion;
 };
 
 template<typename T>
@@ -624,6 +672,7 @@ inline void QUaNode::setUserWriteMaskCallback(const M & callback)
 	m_userWriteMaskCallback = [callback](const QString &strUserName) {
 		return callback(strUserName);
 	};
+	this->clearPermissionsCache();
 }
 
 template<typename M>
@@ -632,6 +681,7 @@ inline void QUaNode::setUserAccessLevelCallback(const M & callback)
 	m_userAccessLevelCallback = [callback](const QString &strUserName) {
 		return callback(strUserName);
 	};
+	this->clearPermissionsCache();
 }
 
 template<typename M>
@@ -640,6 +690,7 @@ inline void QUaNode::setUserExecutableCallback(const M & callback)
 	m_userExecutableCallback = [callback](const QString &strUserName) {
 		return callback(strUserName);
 	};
+	this->clearPermissionsCache();
 }
 
 // to check if has default props static member
@@ -2,9 +2,17 @@
 
 #include <QMetaProperty>
 #include <QTimer>
+#include <QMessageAuthenticationCode>
+#include <random>
+#include <limits>
+#include <QDateTime>
 
 #define QUA_DEBOUNCE_PERIOD_MS 50
 #define QUA_MAX_LOG_MESSAGE_SIZE 1024
+#define QUA_MAX_ASYNC_READS_IN_FLIGHT 64
+#define QUA_MAX_PENDING_CALLS_PER_SESSION 16
+#define QUA_VALUE_QUEUE_CAPACITY 4096
+#define QUA_VALUE_QUEUE_BATCH_SIZE 1024
 
 UA_StatusCode QUaServer::uaConstructor(UA_Server       * server, 
 	                                   const UA_NodeId * sessionId, 
@@ -207,11 +215,8 @@ UA_StatusCode QUaServer::methodCallback(UA_Server        * server,
 	                                    UA_Variant       * output)
 {
 	Q_UNUSED(server        );
-	Q_UNUSED(sessionId     );
 	Q_UNUSED(sessionContext);
 	Q_UNUSED(objectId      );
-	Q_UNUSED(inputSize     );
-	Q_UNUSED(outputSize    );
 	// get node from context object
 #ifdef QT_DEBUG 
 	auto srv = qobject_cast<QUaServer*>(static_cast<QObject*>(methodContext));
@@ -223,9 +228,38 @@ UA_StatusCode QUaServer::methodCallback(UA_Server        * server,
 	{
 		return (UA_StatusCode)UA_STATUSCODE_BADUNEXPECTEDERROR;
 	}
-	Q_ASSERT(srv->m_hashMethods.contains(*methodId));
-	// get method from node callbacks map and call it
-	return srv->m_hashMethods[*methodId](objectContext, input, output);
+	QUaSession * session = srv->sessionById(sessionId);
+	// admission control
+	if (session && !srv->admitRequest(session, QUaSession::Service::Call))
+	{
+		return (UA_StatusCode)UA_STATUSCODE_BADTOOMANYOPERATIONS;
+	}
+	QElapsedTimer timer;
+	timer.start();
+	UA_StatusCode st = srv->callMethod(methodId, objectContext, input, output);
+	// account client call
+	if (session)
+	{
+		session->addCall(timer.nsecsElapsed(), input, inputSize, output, outputSize, st);
+	}
+	return st;
+}
+
+UA_StatusCode QUaServer::callMethod(const UA_NodeId * methodId, void * objectContext, const UA_Variant * input, UA_Variant * output)
+{
+	// per instance override if any
+	auto object = qobject_cast<QUaBaseObject*>(static_cast<QObject*>(objectContext));
+	if (object && !object->m_hashMethods.isEmpty())
+	{
+		auto iter = object->m_hashMethods.find(*methodId);
+		if (iter != object->m_hashMethods.end())
+		{
+			return iter.value()(input, output);
+		}
+	}
+	// else get method from type callbacks map and call it
+	Q_ASSERT(m_hashMethods.contains(*methodId));
+	return m_hashMethods[*methodId](objectContext, input, output);
 }
 
 bool QUaServer::isNodeBound(const UA_NodeId & nodeId, UA_Server *server)
@@ -342,14 +376,20 @@ UA_StatusCode QUaServer::activateSession(UA_Server                    * server,
 
 		// NOTE : custom code : add session to hash
 		Q_ASSERT(!srv->m_hashSessions.contains(*sessionId));
-        srv->m_hashSessions.insert(*sessionId, new QUaSession(srv));
-        srv->m_hashSessions[*sessionId]->m_strUserName = "";
+		QUaSession * session = new QUaSession(srv);
+        srv->m_hashSessions.insert(*sessionId, session);
+        session->m_strUserName = "";
+		// user might have changed, so recompute permissions and rate limits
+		session->m_permissionsVersion = 0;
+		session->m_rateLimitsVersion  = 0;
+		// keep open62541 session to avoid looking it up later
+		session->m_uaSession = QUaServer::uaSessionFromContext(sessionContext, sessionId);
 
 		// notify client connected
-		QUaServer::newSession(srv, sessionId);
+		QUaServer::newSession(srv, session);
 
-		/* No userdata atm */
-		*sessionContext = NULL;
+		// NOTE : custom code : session context is the QUaSession instance
+		*sessionContext = session;
 		return (UA_StatusCode)UA_STATUSCODE_GOOD;
 	}
 
@@ -374,17 +414,24 @@ UA_StatusCode QUaServer::activateSession(UA_Server                    * server,
 		// NOTE : custom code : add session to hash
 		// NOTE : actually is possible for a current session to change its user while maintaining nodeId
 		//Q_ASSERT(!srv->m_hashSessions.contains(*sessionId));
-        if(!srv->m_hashSessions.contains(*sessionId))
+		QUaSession * session = srv->m_hashSessions.value(*sessionId, nullptr);
+        if(!session)
         {
-            srv->m_hashSessions.insert(*sessionId, new QUaSession(srv));
+			session = new QUaSession(srv);
+            srv->m_hashSessions.insert(*sessionId, session);
         }
-        srv->m_hashSessions[*sessionId]->m_strUserName = "";
+        session->m_strUserName = "";
+		// user might have changed, so recompute permissions and rate limits
+		session->m_permissionsVersion = 0;
+		session->m_rateLimitsVersion  = 0;
+		// keep open62541 session to avoid looking it up later
+		session->m_uaSession = QUaServer::uaSessionFromContext(sessionContext, sessionId);
 
 		// notify client connected
-		QUaServer::newSession(srv, sessionId);
+		QUaServer::newSession(srv, session);
 
-		/* No userdata atm */
-		*sessionContext = NULL;
+		// NOTE : custom code : session context is the QUaSession instance
+		*sessionContext = session;
 		return (UA_StatusCode)UA_STATUSCODE_GOOD;
 	}
 
@@ -412,8 +459,8 @@ UA_StatusCode QUaServer::activateSession(UA_Server                    * server,
 		// NOTE : custom code : check user and password
 		const QString userName = QString::fromUtf8((char*)userToken->userName.data, (int)userToken->userName.length);
 		const QString password = QString::fromUtf8((char*)userToken->password.data, (int)userToken->password.length);	
-		// Call validation callback
-		UA_Boolean match = srv->m_validationCallback(userName, password);
+		// Call validation callback (or reuse recent successful login)
+		UA_Boolean match = srv->validateLogin(userName, password);
 		if (!match)
 		{
 			return UA_STATUSCODE_BADUSERACCESSDENIED;			
@@ -428,18 +475,25 @@ UA_StatusCode QUaServer::activateSession(UA_Server                    * server,
 
 		// NOTE : actually is possible for a current session to change its user while maintaining nodeId
 		//Q_ASSERT(!srv->m_hashSessions.contains(*sessionId));
-        if(!srv->m_hashSessions.contains(*sessionId))
+		// NOTE : custom code : add session to hash
+		QUaSession * session = srv->m_hashSessions.value(*sessionId, nullptr);
+        if(!session)
         {
-            srv->m_hashSessions.insert(*sessionId, new QUaSession(srv));
+			session = new QUaSession(srv);
+            srv->m_hashSessions.insert(*sessionId, session);
         }
-		// NOTE : custom code : add session to hash
-        srv->m_hashSessions[*sessionId]->m_strUserName = userName;
+        session->m_strUserName = userName;
+		// user might have changed, so recompute permissions and rate limits
+		session->m_permissionsVersion = 0;
+		session->m_rateLimitsVersion  = 0;
+		// keep open62541 session to avoid looking it up later
+		session->m_uaSession = QUaServer::uaSessionFromContext(sessionContext, sessionId);
 
 		// notify client connected
-		QUaServer::newSession(srv, sessionId);
+		QUaServer::newSession(srv, session);
 
-		/* No userdata atm */
-		*sessionContext = NULL;
+		// NOTE : custom code : session context is the QUaSession instance
+		*sessionContext = session;
 
 		return (UA_StatusCode)UA_STATUSCODE_GOOD;
 	}
@@ -448,37 +502,57 @@ UA_StatusCode QUaServer::activateSession(UA_Server                    * server,
 	return UA_STATUSCODE_BADIDENTITYTOKENINVALID;
 }
 
-void QUaServer::newSession(QUaServer* server,
-	                       const UA_NodeId* sessionId)
+void * QUaServer::uaSessionFromContext(void           **sessionContext,
+	                                   const UA_NodeId *sessionId)
+{
+	auto uaSession = reinterpret_cast<UA_Session*>(
+		reinterpret_cast<char*>(sessionContext) - offsetof(UA_Session, sessionHandle)
+	);
+	Q_ASSERT(UA_NodeId_equal(&uaSession->sessionId, sessionId));
+	Q_UNUSED(sessionId);
+	return uaSession;
+}
+
+void QUaServer::newSession(QUaServer  * server,
+	                       QUaSession * session)
 {
+	Q_ASSERT(session && session->m_uaSession);
+	auto uaSession = static_cast<UA_Session*>(session->m_uaSession);
 	// get session data
-	QString strApplicationName;
-	QString strApplicationUri;
-	QString strProductUri;
-	auto sm = &server->m_server->sessionManager;
-	session_list_entry* current, * temp_s;
-	LIST_FOREACH_SAFE(current, &sm->sessions, pointers, temp_s) 
-	{
-		UA_Session* session = &current->session;
-		if (!UA_NodeId_equal(&session->sessionId, sessionId))
-		{
-			continue;
-		}
-		UA_ApplicationDescription clientDescription = session->clientDescription;
-		Q_ASSERT(clientDescription.applicationType == UA_APPLICATIONTYPE_CLIENT);
-		strApplicationUri  = QUaTypesConverter::uaStringToQString(clientDescription.applicationUri);
-		strProductUri      = QUaTypesConverter::uaStringToQString(clientDescription.productUri);
-		strApplicationName = QUaTypesConverter::uaVariantToQVariantScalar<QString, UA_LocalizedText>(&clientDescription.applicationName);
-		break;
-	}
-	// get connection data
+	UA_ApplicationDescription clientDescription = uaSession->clientDescription;
+	Q_ASSERT(clientDescription.applicationType == UA_APPLICATIONTYPE_CLIENT);
+	QString strApplicationUri  = QUaTypesConverter::uaStringToQString(clientDescription.applicationUri);
+	QString strProductUri      = QUaTypesConverter::uaStringToQString(clientDescription.productUri);
+	QString strApplicationName = QUaTypesConverter::uaVariantToQVariantScalar<QString, UA_LocalizedText>(&clientDescription.applicationName);
+	// store session data
+    session->m_strSessionId       = QUaTypesConverter::nodeIdToQString(uaSession->sessionId);
+    session->m_strApplicationName = strApplicationName;
+    session->m_strApplicationUri  = strApplicationUri;
+    session->m_strProductUri      = strProductUri;
+	// peer address of the channel attached so far, updated on the first request
+	// after activation because a re-activation attaches the new channel afterwards
+	QUaServer::updateSessionAddress(session);
+	session->m_addressStale = true;
+	// emit new client connected event
+	emit server->clientConnected(session);
+}
+
+void QUaServer::updateSessionAddress(QUaSession * session)
+{
+	Q_ASSERT(session && session->m_uaSession);
+	auto uaSession = static_cast<UA_Session*>(session->m_uaSession);
 	QString strAddress;
 	quint16 intPort;
-	auto cm = &server->m_server->secureChannelManager;
-	// assume new connection is always the last one on the list
-	// sonce we do not have a mechanism to associate it with the sessionId
-	channel_entry* last = TAILQ_LAST(&cm->channels, channel_list);
-	UA_Connection* connection = last->channel.connection;
+	// NOTE : during activateSession the session is still attached to the channel it was
+	//        previously on (a re-activation attaches the new channel after the callback)
+	UA_SecureChannel* channel = uaSession->header.channel;
+	UA_Connection* connection = channel ? channel->connection : nullptr;
+	if (!connection)
+	{
+		session->m_strAddress = "Unknown";
+		session->m_intPort    = 0;
+		return;
+	}
 	// get peer name (address) from socket fd
 	auto sockFd = connection->sockfd;
 	sockaddr address;
@@ -514,16 +588,8 @@ void QUaServer::newSession(QUaServer* server,
 		}
 
 	}
-	// store session data
-	Q_ASSERT(server->m_hashSessions.contains(*sessionId));
-    server->m_hashSessions[*sessionId]->m_strSessionId       = QUaTypesConverter::nodeIdToQString(*sessionId);
-    server->m_hashSessions[*sessionId]->m_strApplicationName = strApplicationName;
-    server->m_hashSessions[*sessionId]->m_strApplicationUri	 = strApplicationUri;
-    server->m_hashSessions[*sessionId]->m_strProductUri		 = strProductUri;
-    server->m_hashSessions[*sessionId]->m_strAddress		 = strAddress;
-    server->m_hashSessions[*sessionId]->m_intPort			 = intPort;
-	// emit new client connected event
-	emit server->clientConnected(server->m_hashSessions[*sessionId]);
+	session->m_strAddress = strAddress;
+	session->m_intPort    = intPort;
 }
 
 void QUaServer::closeSession(UA_Server        * server, 
@@ -531,12 +597,23 @@ void QUaServer::closeSession(UA_Server        * server,
 	                         const UA_NodeId  * sessionId, 
 	                         void             * sessionContext)
 {
-	Q_UNUSED(sessionContext);
 	Q_UNUSED(ac);
 	// get server
 	QUaServer *srv = QUaServer::getServerNodeContext(server);
 	// remove session form hash
 	auto session = srv->m_hashSessions.take(*sessionId);
+	Q_ASSERT(!sessionContext || sessionContext == session);
+	Q_UNUSED(sessionContext);
+	if (!session)
+	{
+		return;
+	}
+	// open62541 session is about to be deleted
+	session->m_uaSession = nullptr;
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	// nobody waits for the results anymore
+	srv->cancelPendingCalls(session);
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 	emit srv->clientDisconnected(session);
 	session->deleteLater();
 }
@@ -549,15 +626,12 @@ UA_UInt32 QUaServer::getUserRightsMask(UA_Server        *server,
 	                                   void             *nodeContext) 
 {
 	Q_UNUSED(nodeContext);
-	Q_UNUSED(sessionContext);
 	Q_UNUSED(ac);
 	// get server
 	QUaServer *srv = QUaServer::getServerNodeContext(server);
-	Q_ASSERT(srv->m_hashSessions.contains(*sessionId));
-	// get user
-    QString strUserName = srv->m_hashSessions[*sessionId]->m_strUserName;
-	// check if user still exists
-	if (!strUserName.isEmpty() && !srv->userExists(strUserName))
+	// get session, checks if user still exists
+	QUaSession *session = srv->getValidSession(*sessionId, sessionContext);
+	if (!session)
 	{
 		// TODO : wait until officially supported
 		// https://github.com/open62541/open62541/issues/2617
@@ -569,7 +643,14 @@ UA_UInt32 QUaServer::getUserRightsMask(UA_Server        *server,
 	QUaNode * node = QUaNode::getNodeContext(*nodeId, server);
 	if (node)
 	{
-		return node->userWriteMaskInternal(strUserName).intValue;
+		auto iter = session->m_hashUserWriteMask.find(node);
+		if (iter == session->m_hashUserWriteMask.end())
+		{
+			UA_UInt32 writeMask = srv->userPermissions(session->m_strUserName, node).bits.bWrite ?
+				node->userWriteMaskInternal(session->m_strUserName).intValue : 0;
+			iter = session->m_hashUserWriteMask.insert(node, writeMask);
+		}
+		return iter.value();
 	}
 	// else default
 	return 0xFFFFFFFF;
@@ -583,15 +664,12 @@ UA_Byte QUaServer::getUserAccessLevel(UA_Server        *server,
 	                                  void             *nodeContext)
 {
 	Q_UNUSED(nodeContext);
-	Q_UNUSED(sessionContext);
 	Q_UNUSED(ac);
 	// get server
 	QUaServer *srv = QUaServer::getServerNodeContext(server);
-	Q_ASSERT(srv->m_hashSessions.contains(*sessionId));
-	// get user
-    QString strUserName = srv->m_hashSessions[*sessionId]->m_strUserName;
-	// check if user still exists
-	if (!strUserName.isEmpty() && !srv->userExists(strUserName))
+	// get session, checks if user still exists
+	QUaSession *session = srv->getValidSession(*sessionId, sessionContext);
+	if (!session)
 	{
 		// TODO : wait until officially supported
 		// https://github.com/open62541/open62541/issues/2617
@@ -599,12 +677,32 @@ UA_Byte QUaServer::getUserAccessLevel(UA_Server        *server,
 		//Q_ASSERT(st == UA_STATUSCODE_GOOD);
 		return (UA_UInt32)0;
 	}
+	// NOTE : counts value attribute access checks, i.e. client reads but also subscription
+	//        sampling, write checks and UserAccessLevel reads (no per Read request hook in v1.0)
+	++session->m_requestCount[static_cast<int>(QUaSession::Service::Read)];
+	// NOTE : not rate limited here, denying access would also fail sampling of monitored items
 	// if node from user tree then call user implementation
 	QUaNode * node = QUaNode::getNodeContext(*nodeId, server);
 	QUaBaseVariable * variable = qobject_cast<QUaBaseVariable *>(node);
 	if (variable)
 	{
-		return variable->userAccessLevelInternal(strUserName).intValue;
+		auto iter = session->m_hashUserAccessLevel.find(variable);
+		if (iter == session->m_hashUserAccessLevel.end())
+		{
+			UA_Byte accessLevel = variable->userAccessLevelInternal(session->m_strUserName).intValue;
+			QUaPermissions permissions = srv->userPermissions(session->m_strUserName, variable);
+			if (!permissions.bits.bRead)
+			{
+				accessLevel &= ~(UA_ACCESSLEVELMASK_READ | UA_ACCESSLEVELMASK_HISTORYREAD);
+			}
+			if (!permissions.bits.bWrite)
+			{
+				accessLevel &= ~(UA_ACCESSLEVELMASK_WRITE | UA_ACCESSLEVELMASK_HISTORYWRITE | UA_ACCESSLEVELMASK_SEMANTICCHANGE |
+					             UA_ACCESSLEVELMASK_STATUSWRITE | UA_ACCESSLEVELMASK_TIMESTAMPWRITE);
+			}
+			iter = session->m_hashUserAccessLevel.insert(variable, accessLevel);
+		}
+		return iter.value();
 	}
 	// else default
 	return 0xFF;
@@ -620,17 +718,14 @@ UA_Boolean QUaServer::getUserExecutable(UA_Server        *server,
 {
 	Q_UNUSED(methodContext);
 	Q_UNUSED(methodId);
-	Q_UNUSED(sessionContext);
 	Q_UNUSED(ac);
 	// overall execution permissions for method regardless of conntext object
 	// boils down to whether user exists
 	// get server
 	QUaServer *srv = QUaServer::getServerNodeContext(server);
-	Q_ASSERT(srv->m_hashSessions.contains(*sessionId));
-	// get user
-    QString strUserName = srv->m_hashSessions[*sessionId]->m_strUserName;
-	// check if user still exists
-	if (!strUserName.isEmpty() && !srv->userExists(strUserName))
+	// get session, checks if user still exists
+	QUaSession *session = srv->getValidSession(*sessionId, sessionContext);
+	if (!session)
 	{
 		// TODO : wait until officially supported
 		// https://github.com/open62541/open62541/issues/2617
@@ -654,15 +749,12 @@ UA_Boolean QUaServer::getUserExecutableOnObject(UA_Server        *server,
 	Q_UNUSED(objectContext);
 	Q_UNUSED(methodContext);
 	Q_UNUSED(methodId);
-	Q_UNUSED(sessionContext);
 	Q_UNUSED(ac);
 	// get server
 	QUaServer *srv = QUaServer::getServerNodeContext(server);
-	Q_ASSERT(srv->m_hashSessions.contains(*sessionId));
-	// get user
-    QString strUserName = srv->m_hashSessions[*sessionId]->m_strUserName;
-	// check if user still exists
-	if (!strUserName.isEmpty() && !srv->userExists(strUserName))
+	// get session, checks if user still exists
+	QUaSession *session = srv->getValidSession(*sessionId, sessionContext);
+	if (!session)
 	{
 		// TODO : wait until officially supported
 		// https://github.com/open62541/open62541/issues/2617
@@ -676,7 +768,14 @@ UA_Boolean QUaServer::getUserExecutableOnObject(UA_Server        *server,
 	if (object)
 	{
 		// NOTE : could not diff by method name because name multiples are possible
-		return object->userExecutableInternal(strUserName);
+		auto iter = session->m_hashUserExecutable.find(object);
+		if (iter == session->m_hashUserExecutable.end())
+		{
+			UA_Boolean executable = srv->userPermissions(session->m_strUserName, object).bits.bExecute &&
+				object->userExecutableInternal(session->m_strUserName);
+			iter = session->m_hashUserExecutable.insert(object, executable);
+		}
+		return iter.value();
 	}
 	// else default
 	return true;
@@ -688,6 +787,31 @@ QUaServer::QUaServer(QObject* parent/* = 0*/)
 	// defaults
 	m_port = 4840;
 	m_anonymousLoginAllowed = true;
+	m_maxAsyncReadsInFlight = QUA_MAX_ASYNC_READS_IN_FLIGHT;
+	m_asyncReadsInFlight    = 0;
+	m_maxPendingCallsPerSession = QUA_MAX_PENDING_CALLS_PER_SESSION;
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	m_lastCallHandle = 0;
+	m_callTimer.setSingleShot(true);
+	QObject::connect(&m_callTimer, &QTimer::timeout, this, [this]() {
+		qint64 now = QDateTime::currentMSecsSinceEpoch();
+		QList<quint32> listExpired;
+		for (auto iter = m_hashPendingCalls.cbegin(); iter != m_hashPendingCalls.cend(); ++iter)
+		{
+			if (iter.value().deadline <= now)
+			{
+				listExpired << iter.key();
+			}
+		}
+		for (auto handle : listExpired)
+		{
+			this->completeCall(handle, true);
+		}
+		this->startCallTimer();
+	});
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	m_valueQueue            = new QUaValueQueue(QUA_VALUE_QUEUE_CAPACITY);
+	m_valueQueueBatchSize   = QUA_VALUE_QUEUE_BATCH_SIZE;
 	m_byteCertificate = QByteArray();
 	m_byteCertificateInternal = QByteArray();
 #ifdef UA_ENABLE_ENCRYPTION
@@ -702,22 +826,382 @@ QUaServer::QUaServer(QObject* parent/* = 0*/)
 }
 
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
-void QUaServer::addChange(const QUaChangeStructureDataType& change)
+void QUaServer::addChange(QUaNode * parentNode, const QString & strNodeId, const QUaChangeVerb & verb)
 {
-	if (m_listChanges.contains(change))
+	Q_CHECK_PTR(parentNode);
+	// node deleted before the change of its addition was triggered, both cancel out
+	if (verb == QUaChangeVerb::ReferenceDeleted && m_hashAddedNodes.contains(strNodeId))
+	{
+		QUaChangeKey addedKey = m_hashAddedNodes.take(strNodeId);
+		int index = m_hashChanges.value(addedKey, -1);
+		if (index >= 0 && --m_listChanges[index].addedCount == 0 && !m_listChanges[index].keep)
+		{
+			this->cancelChange(addedKey);
+		}
+		return;
+	}
+	// merge into parent entry, type definition only browsed for new entries
+	QUaChangeKey key(parentNode->nodeId(), static_cast<uchar>(verb));
+	int index = m_hashChanges.value(key, -1);
+	if (index < 0)
+	{
+		index = m_listChanges.count();
+		m_listChanges.append({
+			{ key.first, parentNode->typeDefinitionNodeId(), verb },
+			0,
+			false,
+			false
+		});
+		m_hashChanges.insert(key, index);
+	}
+	QUaChangeEntry &entry = m_listChanges[index];
+	if (verb == QUaChangeVerb::ReferenceAdded && !strNodeId.isEmpty())
+	{
+		entry.addedCount++;
+		m_hashAddedNodes.insert(strNodeId, key);
+	}
+	else
+	{
+		entry.keep = true;
+	}
+	// buffer only while inside a scope
+	if (m_modelChangeScopes > 0)
 	{
 		return;
 	}
-	m_listChanges.append(change);
 	m_triggerChanges();
 }
+
+void QUaServer::cancelChanges(const QString & strNodeId)
+{
+	if (m_hashChanges.isEmpty())
+	{
+		return;
+	}
+	// entries affecting the node, any verb
+	QList<QUaChangeKey> listKeys;
+	for (auto iter = m_hashChanges.cbegin(); iter != m_hashChanges.cend(); ++iter)
+	{
+		if (iter.key().first == strNodeId)
+		{
+			listKeys << iter.key();
+		}
+	}
+	for (auto &key : listKeys)
+	{
+		this->cancelChange(key);
+	}
+}
+
+void QUaServer::cancelChange(const QUaChangeKey & key)
+{
+	int index = m_hashChanges.take(key);
+	m_listChanges[index].cancelled = true;
+	// children added to the entry are gone with it
+	for (auto iter = m_hashAddedNodes.begin(); iter != m_hashAddedNodes.end();)
+	{
+		if (iter.value() == key)
+		{
+			iter = m_hashAddedNodes.erase(iter);
+			continue;
+		}
+		++iter;
+	}
+}
+
+void QUaServer::clearChanges()
+{
+	m_listChanges.clear();
+	m_hashChanges.clear();
+	m_hashAddedNodes.clear();
+}
+
+void QUaServer::triggerChanges()
+{
+	if (m_modelChangeScopes > 0 || m_hashChanges.isEmpty())
+	{
+		return;
+	}
+	QUaChangesList listChanges;
+	listChanges.reserve(m_hashChanges.count());
+	for (auto &entry : m_listChanges)
+	{
+		if (!entry.cancelled)
+		{
+			listChanges.append(entry.change);
+		}
+	}
+	// clean buffer before triggering, in case a slot adds changes
+	this->clearChanges();
+	// trigger
+	m_changeEvent->setChanges(listChanges);
+	m_changeEvent->setTime(QDateTime::currentDateTimeUtc());
+	m_changeEvent->trigger();
+}
+
+void QUaServer::beginModelChanges(QUaNode * summaryNode/* = nullptr*/)
+{
+	m_modelChangeScopes++;
+	if (!summaryNode)
+	{
+		return;
+	}
+	Q_ASSERT(summaryNode->server() == this);
+	// verb is set on end, to the verbs of the buffered changes
+	m_listSummaryChanges.append({
+		summaryNode->nodeId(),
+		summaryNode->typeDefinitionNodeId(),
+		QUaChangeVerb::ReferenceAdded
+	});
+}
+
+void QUaServer::endModelChanges()
+{
+	Q_ASSERT_X(m_modelChangeScopes > 0, "QUaServer::endModelChanges", "No model change scope to end.");
+	if (m_modelChangeScopes == 0 || --m_modelChangeScopes > 0)
+	{
+		return;
+	}
+	// replace buffered changes by the summary nodes
+	if (!m_listSummaryChanges.isEmpty() && !m_hashChanges.isEmpty())
+	{
+		uchar uiVerbs = 0;
+		for (auto &entry : m_listChanges)
+		{
+			if (!entry.cancelled)
+			{
+				uiVerbs |= entry.change.m_uiVerb;
+			}
+		}
+		this->clearChanges();
+		for (int i = 0; i < m_listSummaryChanges.count(); i++)
+		{
+			QUaChangeStructureDataType summary = m_listSummaryChanges.at(i);
+			summary.m_uiVerb = uiVerbs;
+			QUaChangeKey key(summary.m_strNodeIdAffected, uiVerbs);
+			if (m_hashChanges.contains(key))
+			{
+				continue;
+			}
+			m_hashChanges.insert(key, m_listChanges.count());
+			m_listChanges.append({ summary, 0, true, false });
+		}
+	}
+	m_listSummaryChanges.clear();
+	// single event for the whole scope, no need to wait for debounce
+	this->triggerChanges();
+}
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+void QUaServer::triggerMonitoredItems(QUaBaseVariable * variable)
+{
+	auto iter = m_hashMonitoredItems.find(variable);
+	while (iter != m_hashMonitoredItems.end() && iter.key() == variable)
+	{
+		UA_MonitoredItem * mon = iter.value();
+		// sample now, notification is only queued if value changed
+		if (mon->monitoringMode != UA_MONITORINGMODE_DISABLED)
+		{
+			UA_MonitoredItem_sampleCallback(m_server, mon);
+		}
+		++iter;
+	}
+}
+
+void QUaServer::setMonitoredItemsSampling(QUaBaseVariable * variable, const bool & enabled)
+{
+	auto iter = m_hashMonitoredItems.find(variable);
+	while (iter != m_hashMonitoredItems.end() && iter.key() == variable)
+	{
+		UA_MonitoredItem * mon = iter.value();
+		if (!enabled)
+		{
+			UA_MonitoredItem_unregisterSampleCallback(m_server, mon);
+		}
+		else if (mon->monitoringMode != UA_MONITORINGMODE_DISABLED)
+		{
+			auto st = UA_MonitoredItem_registerSampleCallback(m_server, mon);
+			Q_ASSERT(st == UA_STATUSCODE_GOOD);
+			Q_UNUSED(st);
+		}
+		++iter;
+	}
+}
+
+// [STATIC]
+void QUaServer::monitoredItemRegister(UA_Server        *server,
+	                                  const UA_NodeId  *sessionId,
+	                                  void             *sessionContext,
+	                                  const UA_NodeId  *nodeId,
+	                                  void             *nodeContext,
+	                                  UA_UInt32         attibuteId,
+	                                  UA_Boolean        removed)
+{
+	Q_UNUSED(sessionContext);
+	QUaServer * srv = QUaServer::getServerNodeContext(server);
+	// account monitored items per session
+	// NOTE : session might be already gone when its items are removed
+	QUaSession * session = srv->sessionById(sessionId);
+	if (session)
+	{
+		if (removed)
+		{
+			Q_ASSERT(session->m_monitoredItems > 0);
+			session->m_monitoredItems--;
+		}
+		else
+		{
+			session->m_monitoredItems++;
+		}
+	}
+	// only interested in variable values
+	if (attibuteId != UA_ATTRIBUTEID_VALUE || !nodeContext)
+	{
+		return;
+	}
+	auto variable = qobject_cast<QUaBaseVariable*>(static_cast<QObject*>(nodeContext));
+	if (!variable)
+	{
+		return;
+	}
+	// NOTE : nodeId points to UA_MonitoredItem::monitoredNodeId (see quaserver_anex.h)
+	auto mon = reinterpret_cast<UA_MonitoredItem*>(
+		reinterpret_cast<char*>(const_cast<UA_NodeId*>(nodeId)) - offsetof(UA_MonitoredItem, monitoredNodeId)
+	);
+	Q_ASSERT(UA_NodeId_equal(&mon->monitoredNodeId, &variable->m_nodeId));
+	if (removed)
+	{
+		srv->m_hashMonitoredItems.remove(variable, mon);
+		return;
+	}
+	srv->m_hashMonitoredItems.insert(variable, mon);
+	// stop periodic sampling if notified by variable
+	// NOTE : client can restart it by modifying the monitored item
+	if (variable->m_bExceptionBasedReporting && !variable->m_bDataSource)
+	{
+		UA_MonitoredItem_unregisterSampleCallback(server, mon);
+	}
+}
+#endif // UA_ENABLE_SUBSCRIPTIONS
+
+struct QUaValueShape
+{
+	UA_Int32         valueRank;
+	size_t           arrayDimensionsSize;
+	const UA_UInt32 *arrayDimensions;
+};
+
+static UA_StatusCode editValueShape(UA_Server *server, UA_Session *session, UA_Node *node, void *data)
+{
+	Q_UNUSED(server);
+	Q_UNUSED(session);
+	if (node->nodeClass != UA_NODECLASS_VARIABLE)
+	{
+		return UA_STATUSCODE_BADNODECLASSINVALID;
+	}
+	auto shape   = static_cast<QUaValueShape*>(data);
+	auto varNode = reinterpret_cast<UA_VariableNode*>(node);
+	// copy new dimensions
+	UA_UInt32 * arrayDimensions = nullptr;
+	if (shape->arrayDimensionsSize > 0)
+	{
+		auto st = UA_Array_copy(shape->arrayDimensions, shape->arrayDimensionsSize,
+			reinterpret_cast<void**>(&arrayDimensions), &UA_TYPES[UA_TYPES_UINT32]);
+		if (st != UA_STATUSCODE_GOOD)
+		{
+			return st;
+		}
+	}
+	// replace old ones
+	UA_Array_delete(varNode->arrayDimensions, varNode->arrayDimensionsSize, &UA_TYPES[UA_TYPES_UINT32]);
+	varNode->arrayDimensions     = arrayDimensions;
+	varNode->arrayDimensionsSize = shape->arrayDimensionsSize;
+	varNode->valueRank           = shape->valueRank;
+	return UA_STATUSCODE_GOOD;
+}
+
+UA_StatusCode QUaServer::writeValueShape(const UA_NodeId & nodeId, const qint32 & valueRank, const QVector<quint32> & arrayDimensions)
+{
+	QUaValueShape shape;
+	shape.valueRank           = valueRank;
+	shape.arrayDimensionsSize = static_cast<size_t>(arrayDimensions.size());
+	shape.arrayDimensions     = arrayDimensions.constData();
+	return UA_Server_editNode(m_server, &m_server->adminSession, &nodeId, &editValueShape, &shape);
+}
+
 #ifdef UA_ENABLE_HISTORIZING
 UA_HistoryDataGathering QUaServer::getGathering() const
 {
 	return static_cast<UA_HistoryDatabaseContext_default*>(m_historDatabase.context)->gathering;
 }
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+bool QUaServer::eventHistorizing() const
+{
+	return m_eventHistorizing;
+}
+
+void QUaServer::setEventHistorizing(const bool& eventHistorizing, const QStringList& fields/* = QStringList()*/)
+{
+	Q_ASSERT_X(!eventHistorizing || m_historBackend.hasEventHistory(), "QUaServer::setEventHistorizing", "Historizer does not implement the events API.");
+	m_eventHistorizing      = eventHistorizing && m_historBackend.hasEventHistory();
+	m_eventHistoryFields    = fields;
+	// NOTE : QList::toSet is deprecated in newer Qt and the range constructor is missing in older
+	m_setEventHistoryFields.clear();
+	for (const auto &field : fields)
+	{
+		m_setEventHistoryFields.insert(field);
+	}
+}
+
+QStringList QUaServer::eventHistoryFields() const
+{
+	return m_eventHistoryFields;
+}
+
+QVector<QUaHistoryEventPoint> QUaServer::readHistoryEvents(
+	const QUaDateTime& timeStart, 
+	const QUaDateTime& timeEnd, 
+	const QUaHistoryEventFilter& filter/* = QUaHistoryEventFilter()*/, 
+	const quint64& numEventsToRead/* = 0*/)
+{
+	QQueue<QUaLog> logOut;
+	auto events = m_historBackend.readHistoryEvents(
+		timeStart,
+		timeEnd,
+		filter,
+		numEventsToRead,
+		logOut
+	);
+	QUaHistoryBackend::processServerLog(this, logOut);
+	return events;
+}
+
+void QUaServer::historizeEvent(QUaBaseEvent* event, const UA_NodeId& sourceNodeId)
+{
+	Q_CHECK_PTR(event);
+	QUaHistoryEventPoint eventPoint;
+	eventPoint.timestamp       = event->time();
+	eventPoint.strSourceNodeId = QUaTypesConverter::nodeIdToQString(sourceNodeId);
+	eventPoint.strEventType    = QUaTypesConverter::nodeIdToQString(
+		m_mapTypes.value(QString(event->metaObject()->className()), UA_NODEID_NULL));
+	eventPoint.severity        = event->severity();
+	// read selected fields after trigger, so EventId and ReceiveTime are up to date
+	for (auto field : event->findChildren<QUaBaseVariable*>(QString(), Qt::FindDirectChildrenOnly))
+	{
+		QString strName = field->objectName();
+		if (!m_setEventHistoryFields.isEmpty() && !m_setEventHistoryFields.contains(strName))
+		{
+			continue;
+		}
+		eventPoint.fields.insert(strName, field->value());
+	}
+	QQueue<QUaLog> logOut;
+	m_historBackend.writeHistoryEventPoint(eventPoint, logOut);
+	QUaHistoryBackend::processServerLog(this, logOut);
+}
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 #endif // UA_ENABLE_HISTORIZING
 
 void QUaServer::resetConfig()
@@ -776,6 +1260,11 @@ void QUaServer::resetConfig()
 	config->accessControl.getUserExecutable         = &QUaServer::getUserExecutable;
 	config->accessControl.getUserExecutableOnObject = &QUaServer::getUserExecutableOnObject;
 
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+	// keep track of monitored items to support exception based reporting
+	config->monitoredItemRegisterCallback = &QUaServer::monitoredItemRegister;
+#endif // UA_ENABLE_SUBSCRIPTIONS
+
 	// TODO : implement rest of callbacks
 	//        allowAddNode_default
 	//        allowAddReference_default
@@ -851,6 +1340,7 @@ void QUaServer::setupServer()
 	{
 		qRegisterMetaType<QUaDataType>("QUaDataType");
 	}
+	QUaTypesConverter::setDateTimeTypeId(qRegisterMetaType<QUaDateTime>("QUaDateTime"));
 	QMetaType::registerConverter<QUaDataType, QString>([](QUaDataType type) {
         return type.operator QString();
 	});
@@ -860,14 +1350,22 @@ void QUaServer::setupServer()
 	// Server stuff
 	UA_StatusCode st;
 	m_running = false;
+	// sessions start with a stale permissions cache
+	m_permissionsVersion = 1;
+	// nodes start with stale role masks
+	m_rolesVersion = 1;
+	// requests unlimited by default
+	std::fill(m_rateLimits, m_rateLimits + QUaSession::ServiceCount, QUaServer::validRateLimit(0, 0));
+	m_rateLimitsVersion = 1;
+	m_rateTimer.start();
 	// Set default validation callback
 	m_validationCallback = [this](const QString& strUserName, const QString& strPassword) {
-		if (!m_hashUsers.contains(strUserName))
-		{
-			return false;
-		}
-		return m_hashUsers[strUserName].compare(strPassword, Qt::CaseSensitive) == 0;
+		return this->verifyUserKey(strUserName, strPassword);
 	};
+	// credentials
+	m_keyHashIterations = QUA_KEY_HASH_ITERATIONS;
+	m_loginCacheTimeout = QUA_LOGIN_CACHE_TIMEOUT;
+	m_loginCacheSecret = QUaServer::randomBytes(32);
 	// Create "Objects" folder using special constructor
 	// Part 5 - 8.2.4 : Objects
 	auto objectsNodeId = UA_NODEID_NUMERIC(0, UA_NS0ID_OBJECTSFOLDER);
@@ -967,6 +1465,12 @@ void QUaServer::setupServer()
 
 	// instantiate change event
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	m_suppressedEventCount = 0;
+	m_suppressionWindowCount = 0;
+	m_modelChangeScopes    = 0;
+#ifdef UA_ENABLE_HISTORIZING
+	m_eventHistorizing = false;
+#endif // UA_ENABLE_HISTORIZING
 	m_changeEvent = this->createEvent<QUaGeneralModelChangeEvent>();
 	Q_CHECK_PTR(m_changeEvent);
 	m_changeEvent->setSourceName(this->applicationName());
@@ -975,12 +1479,7 @@ void QUaServer::setupServer()
 	// create debounced trigerring function
 	m_triggerChanges = QFunctionUtils::Debounce(
 		[this]() {
-			// trigger
-			m_changeEvent->setChanges(m_listChanges);
-			m_changeEvent->setTime(QDateTime::currentDateTimeUtc());
-			m_changeEvent->trigger();
-			// clean list of changes buffer
-			m_listChanges.clear();
+			this->triggerChanges();
 		}, QUA_DEBOUNCE_PERIOD_MS);
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 
@@ -1033,8 +1532,19 @@ QUaServer::~QUaServer()
 		delete this->children().at(0);
 	}
 
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	// free values kept to reset reusable events
+	for (auto &eventTemplate : m_hashEventTemplates)
+	{
+		for (auto &defaultValue : eventTemplate.defaults)
+		{
+			UA_Variant_clear(&defaultValue);
+		}
+	}
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 	// cleanup open62541
 	UA_Server_delete(this->m_server);
+	delete m_valueQueue;
 }
 
 quint16 QUaServer::port() const
@@ -1189,9 +1699,16 @@ void QUaServer::start()
 		if (!m_running) { return; }
 		// iterate and restart
 		m_iterWaitTimer.stop();
+		// apply values updated from other threads
+		this->drainValueQueue();
 		auto msToWait = UA_Server_run_iterate(m_server, false);
 		msToWait = (std::min)(msToWait, static_cast<UA_UInt16>(0.5 * msToWait));
 		msToWait = (std::max)(msToWait, static_cast<UA_UInt16>(1));
+		// do not wait if still values to apply
+		if (!m_valueQueue->isEmpty())
+		{
+			msToWait = 1;
+		}
 		m_iterWaitTimer.start(msToWait);
 	}, Qt::QueuedConnection);
 	// start iterations
@@ -1214,6 +1731,9 @@ void QUaServer::stop()
 	// [FIX] remove channels and sessions
 	UA_SecureChannelManager_deleteMembers(&m_server->secureChannelManager);
 	UA_SessionManager_deleteMembers(&m_server->sessionManager);
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+	m_hashMonitoredItems.clear();
+#endif // UA_ENABLE_SUBSCRIPTIONS
 
 	// emit event
 	emit this->isRunningChanged(m_running);
@@ -1258,16 +1778,215 @@ void QUaServer::setMaxSessions(const quint16& maxSessions)
 	emit this->maxSessionsChanged(m_maxSessions);
 }
 
-void QUaServer::registerType(const QMetaObject& metaObject, const QString& strNodeId/* = ""*/)
+quint32 QUaServer::maxAsyncReadsInFlight() const
 {
-	// check if OPC UA relevant
-	if (!metaObject.inherits(&QUaNode::staticMetaObject))
+	return m_maxAsyncReadsInFlight;
+}
+
+void QUaServer::setMaxAsyncReadsInFlight(const quint32& maxAsyncReadsInFlight)
+{
+	// NOTE : reads already in flight are not cancelled, new ones wait until below limit
+	m_maxAsyncReadsInFlight = maxAsyncReadsInFlight;
+	emit this->maxAsyncReadsInFlightChanged(m_maxAsyncReadsInFlight);
+}
+
+quint32 QUaServer::maxPendingCallsPerSession() const
+{
+	return m_maxPendingCallsPerSession;
+}
+
+void QUaServer::setMaxPendingCallsPerSession(const quint32& maxPendingCallsPerSession)
+{
+	// NOTE : running calls are not cancelled, new ones fail until below limit
+	m_maxPendingCallsPerSession = maxPendingCallsPerSession;
+	emit this->maxPendingCallsPerSessionChanged(m_maxPendingCallsPerSession);
+}
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+quint32 QUaServer::addPendingCall(const QUaPendingCall & call)
+{
+	Q_CHECK_PTR(call.session);
+	Q_CHECK_PTR(call.watcher);
+	// zero is never used, so clients can tell a handle from an empty output
+	do
 	{
-		Q_ASSERT_X(false, "QUaServer::registerType", "Unsupported base class");
-		return;
-	}
-	// check if already registered
-	QString   strClassName = QString(metaObject.className());
+		++m_lastCallHandle;
+	} while (m_lastCallHandle == 0 || m_hashPendingCalls.contains(m_lastCallHandle));
+	const quint32 handle = m_lastCallHandle;
+	m_hashPendingCalls.insert(handle, call);
+	call.session->m_pendingCalls++;
+	// watcher deleted with the server if the call never completes
+	call.watcher->setParent(this);
+	QObject::connect(call.watcher, &QFutureWatcherBase::finished, this,
+	[this, handle]() {
+		this->completeCall(handle, false);
+	});
+	this->startCallTimer();
+	return handle;
+}
+
+void QUaServer::completeCall(const quint32 & handle, const bool & timedOut)
+{
+	auto iter = m_hashPendingCalls.find(handle);
+	if (iter == m_hashPendingCalls.end())
+	{
+		return;
+	}
+	QUaPendingCall call = iter.value();
+	m_hashPendingCalls.erase(iter);
+	call.session->m_pendingCalls--;
+	// NOTE : can be called from the finished signal of the watcher
+	call.watcher->deleteLater();
+	QVariant result;
+	UA_StatusCode status = UA_STATUSCODE_BADTIMEOUT;
+	if (timedOut)
+	{
+		call.cancel();
+	}
+	else
+	{
+		status = call.result(result);
+	}
+	// object deleted while running, nothing to trigger the event from
+	if (!call.object)
+	{
+		return;
+	}
+	QVariantMap fields;
+	fields["callHandle"] = handle;
+	fields["methodName"] = call.strMethodName;
+	fields["statusCode"] = static_cast<quint32>(status);
+	if (result.isValid())
+	{
+		fields["result"] = result;
+	}
+	fields["Message"] = status == UA_STATUSCODE_GOOD ?
+		QString("Method %1 completed.").arg(call.strMethodName) :
+		QString("Method %1 failed : %2.").arg(call.strMethodName).arg(UA_StatusCode_name(status));
+	this->triggerEvent<QUaMethodCompletedEvent>(call.object.data(), fields);
+}
+
+void QUaServer::cancelPendingCalls(QUaSession * session)
+{
+	for (auto iter = m_hashPendingCalls.begin(); iter != m_hashPendingCalls.end();)
+	{
+		QUaPendingCall &call = iter.value();
+		if (call.session != session)
+		{
+			++iter;
+			continue;
+		}
+		call.cancel();
+		call.watcher->deleteLater();
+		iter = m_hashPendingCalls.erase(iter);
+	}
+	session->m_pendingCalls = 0;
+	this->startCallTimer();
+}
+
+void QUaServer::startCallTimer()
+{
+	if (m_hashPendingCalls.isEmpty())
+	{
+		m_callTimer.stop();
+		return;
+	}
+	qint64 next = std::numeric_limits<qint64>::max();
+	for (auto &call : m_hashPendingCalls)
+	{
+		next = qMin(next, call.deadline);
+	}
+	qint64 wait = next - QDateTime::currentMSecsSinceEpoch();
+	m_callTimer.start(static_cast<int>(qBound(static_cast<qint64>(0), wait, static_cast<qint64>(std::numeric_limits<int>::max()))));
+}
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
+quint32 QUaServer::asyncReadsInFlight() const
+{
+	return m_asyncReadsInFlight;
+}
+
+bool QUaServer::enqueueValue(QUaBaseVariable * variable, const QVariant & value, const QUaDateTime & sourceTimestamp/* = QUaDateTime()*/)
+{
+	Q_CHECK_PTR(variable);
+	// NOTE : enqueue node id copy, variable is resolved by the server thread when drained,
+	//        invalid timestamp is zero ticks, which is not written
+	return m_valueQueue->enqueue(QUaValueUpdate(variable->m_nodeId, value, sourceTimestamp.ticks()));
+}
+
+quint32 QUaServer::valueQueueCapacity() const
+{
+	return m_valueQueue->capacity();
+}
+
+void QUaServer::setValueQueueCapacity(const quint32 & capacity)
+{
+	// producers might be pushing into the queue once running
+	Q_ASSERT_X(!m_running, "QUaServer::setValueQueueCapacity", "Cannot resize value queue while server is running.");
+	if (m_running)
+	{
+		return;
+	}
+	// apply pending updates before replacing queue
+	while (!m_valueQueue->isEmpty())
+	{
+		this->drainValueQueue();
+	}
+	delete m_valueQueue;
+	m_valueQueue = new QUaValueQueue(capacity);
+}
+
+quint32 QUaServer::valueQueueBatchSize() const
+{
+	return m_valueQueueBatchSize;
+}
+
+void QUaServer::setValueQueueBatchSize(const quint32 & batchSize)
+{
+	Q_ASSERT_X(batchSize > 0, "QUaServer::setValueQueueBatchSize", "Batch size must be greater than zero.");
+	m_valueQueueBatchSize = (std::max)(batchSize, static_cast<quint32>(1));
+}
+
+quint32 QUaServer::valueQueueSize() const
+{
+	return m_valueQueue->size();
+}
+
+QUaValueQueueStats QUaServer::valueQueueStats() const
+{
+	return m_valueQueue->stats();
+}
+
+void QUaServer::resetValueQueueStats()
+{
+	m_valueQueue->resetStats();
+}
+
+void QUaServer::drainValueQueue()
+{
+	QUaValueUpdate update;
+	for (quint32 i = 0; i < m_valueQueueBatchSize && m_valueQueue->dequeue(update); i++)
+	{
+		// variable might have been deleted after enqueued
+		QUaBaseVariable * variable = qobject_cast<QUaBaseVariable*>(QUaNode::getNodeContext(update.nodeId, this));
+		if (!variable)
+		{
+			continue;
+		}
+		variable->setValueInternal(update.value, QMetaType::UnknownType, update.sourceTimestamp);
+	}
+}
+
+void QUaServer::registerType(const QMetaObject& metaObject, const QString& strNodeId/* = ""*/)
+{
+	// check if OPC UA relevant
+	if (!metaObject.inherits(&QUaNode::staticMetaObject))
+	{
+		Q_ASSERT_X(false, "QUaServer::registerType", "Unsupported base class");
+		return;
+	}
+	// check if already registered
+	QString   strClassName = QString(metaObject.className());
 	UA_NodeId newTypeNodeId = m_mapTypes.value(strClassName, UA_NODEID_NULL);
 	if (!UA_NodeId_isNull(&newTypeNodeId))
 	{
@@ -1275,9 +1994,7 @@ void QUaServer::registerType(const QMetaObject& metaObject, const QString& strNo
 		return;
 	}
 	// create new type browse name
-	UA_QualifiedName browseName;
-	browseName.namespaceIndex = 1;
-	browseName.name = QUaTypesConverter::uaStringFromQString(strClassName);
+	UA_QualifiedName browseName = QUaTypesConverter::uaQualifiedNameFromQString(strClassName);
 	// check if base class is registered
 	QString strBaseClassName = QString(metaObject.superClass()->className());
 	if (!m_mapTypes.contains(strBaseClassName))
@@ -1563,9 +2280,7 @@ void QUaServer::addMetaProperties(const QMetaObject& parentMetaObject)
 		}
 		Q_ASSERT(!UA_NodeId_isNull(&propTypeNodeId));
 		// set qualified name, default is class name
-		UA_QualifiedName browseName;
-		browseName.namespaceIndex = 1;
-		browseName.name = QUaTypesConverter::uaStringFromQString(strPropName);
+		UA_QualifiedName browseName = QUaTypesConverter::uaQualifiedNameFromQString(strPropName);
 		// display name
 		UA_LocalizedText displayName = UA_LOCALIZEDTEXT((char*)"", bytePropName.data());
 		// check if variable or object
@@ -1626,11 +2341,180 @@ void QUaServer::addMetaProperties(const QMetaObject& parentMetaObject)
 	}
 }
 
-void QUaServer::addMetaMethods(const QMetaObject& parentMetaObject)
+UA_NodeId QUaServer::addTypeMethodNodeInternal(const QMetaObject & metaObject, 
+	                                           QByteArray        & byteMethodName, 
+	                                           const size_t      & nArgs, 
+	                                           UA_Argument       * inputArguments, 
+	                                           UA_Argument       * outputArgument)
 {
-	QString   strParentClassName = QString(parentMetaObject.className());
-	UA_NodeId parentTypeNodeId = m_mapTypes.value(strParentClassName, UA_NODEID_NULL);
+	QString   strClassName = QString(metaObject.className());
+	UA_NodeId parentTypeNodeId = m_mapTypes.value(strClassName, UA_NODEID_NULL);
 	Q_ASSERT(!UA_NodeId_isNull(&parentTypeNodeId));
+	// Q_INVOKABLEs are added on type registration, a type method with the same name would replace it
+	Q_ASSERT_X(!m_hashTypeMethods.value(strClassName).contains(QString::fromUtf8(byteMethodName)),
+		"QUaServer::addTypeMethod",
+		"Type already has a method with the same name, previous method will be overwritten.");
+	// add method node
+	UA_MethodAttributes methAttr = UA_MethodAttributes_default;
+	methAttr.executable = true;
+	methAttr.userExecutable = true;
+	methAttr.description = UA_LOCALIZEDTEXT((char*)"",
+		byteMethodName.data());
+	methAttr.displayName = UA_LOCALIZEDTEXT((char*)"",
+		byteMethodName.data());
+	// create callback
+	UA_NodeId methNodeId;
+	auto st = UA_Server_addMethodNode(this->m_server,
+		UA_NODEID_NULL,
+		parentTypeNodeId,
+		UA_NODEID_NUMERIC(0, UA_NS0ID_HASCOMPONENT),
+		UA_QUALIFIEDNAME(1, byteMethodName.data()),
+		methAttr,
+		&QUaServer::methodCallback,
+		nArgs,
+		inputArguments,
+		outputArgument ? 1 : 0,
+		outputArgument,
+		this, // context is server instance that has m_hashMethods
+		&methNodeId);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+	// Define "StartPump" method mandatory
+	// NOTE : instances reference the type's method node, they do not get a copy
+	st = UA_Server_addReference(this->m_server,
+		methNodeId,
+		UA_NODEID_NUMERIC(0, UA_NS0ID_HASMODELLINGRULE),
+		UA_EXPANDEDNODEID_NUMERIC(0, UA_NS0ID_MODELLINGRULE_MANDATORY),
+		true);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+	// keep by name to resolve per instance overrides
+	m_hashTypeMethods[strClassName][QString::fromUtf8(byteMethodName)] = methNodeId;
+	// keep signature to check overrides
+	m_hashTypeMethodSignatures[methNodeId] = QUaServer::methodSignature(nArgs, inputArguments, outputArgument);
+	return methNodeId;
+}
+
+UA_NodeId QUaServer::typeMethodNodeId(const QMetaObject & metaObject, const QString & strMethodName) const
+{
+	// look in type and its base types
+	for (const QMetaObject * meta = &metaObject; meta; meta = meta->superClass())
+	{
+		auto iter = m_hashTypeMethods.find(QString(meta->className()));
+		if (iter == m_hashTypeMethods.end())
+		{
+			continue;
+		}
+		auto iterMeth = iter.value().find(strMethodName);
+		if (iterMeth != iter.value().end())
+		{
+			return iterMeth.value();
+		}
+	}
+	return UA_NODEID_NULL;
+}
+
+bool QUaServer::matchesTypeMethod(const UA_NodeId & methNodeId, QVector<UA_Argument> inputArguments, UA_Argument outputArgument) const
+{
+	QString strSignature = QUaServer::methodSignature(
+		inputArguments.count(),
+		inputArguments.data(),
+		&outputArgument
+	);
+	// NOTE : only names are allocated, descriptions point to literals
+	for (int i = 0; i < inputArguments.count(); i++)
+	{
+		UA_String_clear(&inputArguments[i].name);
+	}
+	UA_String_clear(&outputArgument.name);
+	return m_hashTypeMethodSignatures.value(methNodeId) == strSignature;
+}
+
+QString QUaServer::methodSignature(const size_t & nArgs, const UA_Argument * inputArguments, const UA_Argument * outputArgument)
+{
+	// data type and value rank of each argument, names are not part of the signature
+	QStringList listArgs;
+	for (size_t i = 0; i < nArgs; i++)
+	{
+		listArgs << QString("%1[%2]")
+			.arg(QUaTypesConverter::nodeIdToQString(inputArguments[i].dataType))
+			.arg(inputArguments[i].valueRank);
+	}
+	// no output argument or null data type means void
+	QString strRet = "void";
+	if (outputArgument && !UA_NodeId_isNull(&outputArgument->dataType))
+	{
+		strRet = QString("%1[%2]")
+			.arg(QUaTypesConverter::nodeIdToQString(outputArgument->dataType))
+			.arg(outputArgument->valueRank);
+	}
+	return QString("(%1)%2").arg(listArgs.join(",")).arg(strRet);
+}
+
+// Precompiled call of a Q_INVOKABLE exposed as OPC UA method
+// NOTE : caches the method index and not the QMetaMethod, because in some cases the internal
+//        data of a cached metamethod was deleted which resulted in access violation
+struct QUaMetaMethodInvoker
+{
+	enum class ArgKind
+	{
+		Scalar,
+		QList,
+		QVector
+	};
+	int              methodIndex;
+	int              returnType;
+	QVector<int>     argTypes;
+	QVector<ArgKind> argKinds;
+
+	UA_StatusCode operator()(QObject * object, const UA_Variant * input, UA_Variant * output) const
+	{
+		// NOTE : arguments need to be kept in stack while method is being called
+		QVariant args[10];
+		void *   argv[11];
+		for (int k = 0; k < argTypes.count(); k++)
+		{
+			switch (argKinds.at(k))
+			{
+			case ArgKind::QList:
+				args[k] = QUaTypesConverter::uaVariantToQVariantArray(input[k], QUaTypesConverter::ArrayType::QList);
+				break;
+			case ArgKind::QVector:
+				args[k] = QUaTypesConverter::uaVariantToQVariantArray(input[k], QUaTypesConverter::ArrayType::QVector);
+				break;
+			default:
+				args[k] = QUaTypesConverter::uaVariantToQVariant(input[k]);
+				break;
+			}
+			// method reads argument as its declared type
+			if (args[k].userType() != argTypes.at(k) && !args[k].convert(argTypes.at(k)))
+			{
+				return (UA_StatusCode)UA_STATUSCODE_BADTYPEMISMATCH;
+			}
+			argv[k + 1] = args[k].data();
+		}
+		// create return value
+		QVariant returnValue;
+		argv[0] = nullptr;
+		if (returnType != QMetaType::Void)
+		{
+			returnValue = QVariant(returnType, static_cast<void*>(NULL));
+			argv[0] = returnValue.data();
+		}
+		// call method directly (same as QMetaMethod::invoke with Qt::DirectConnection)
+		QMetaObject::metacall(object, QMetaObject::InvokeMetaMethod, methodIndex, argv);
+		// set return value if any
+		if (returnType != QMetaType::Void)
+		{
+			*output = QUaTypesConverter::uaVariantFromQVariant(returnValue);
+		}
+		// return success status
+		return (UA_StatusCode)UA_STATUSCODE_GOOD;
+	}
+};
+
+void QUaServer::addMetaMethods(const QMetaObject& parentMetaObject)
+{
 	// loop meta methods and find out which ones inherit from
 	int methCount = parentMetaObject.methodCount();
 	for (int i = parentMetaObject.methodOffset(); i < methCount; i++)
@@ -1735,44 +2619,42 @@ void QUaServer::addMetaMethods(const QMetaObject& parentMetaObject)
 		}
 		// add method
 		auto strMethName = metamethod.name();
-		// add method node
-		UA_MethodAttributes methAttr = UA_MethodAttributes_default;
-		methAttr.executable = true;
-		methAttr.userExecutable = true;
-		methAttr.description = UA_LOCALIZEDTEXT((char*)"",
-			strMethName.data());
-		methAttr.displayName = UA_LOCALIZEDTEXT((char*)"",
-			strMethName.data());
-		// create callback
-		UA_NodeId methNodeId;
-		auto st = UA_Server_addMethodNode(this->m_server,
-			UA_NODEID_NULL,
-			parentTypeNodeId,
-			UA_NODEID_NUMERIC(0, UA_NS0ID_HASCOMPONENT),
-			UA_QUALIFIEDNAME(1, strMethName.data()),
-			methAttr,
-			&QUaServer::methodCallback,
+		UA_NodeId methNodeId = this->addTypeMethodNodeInternal(
+			parentMetaObject,
+			strMethName,
 			metamethod.parameterCount(),
 			vectArgs.data(),
-			outputArgument ? 1 : 0,
-			outputArgument,
-			this, // context is server instance that has m_hashMethods
-			&methNodeId);
-		Q_ASSERT(st == UA_STATUSCODE_GOOD);
-		Q_UNUSED(st);
-		// Define "StartPump" method mandatory
-		st = UA_Server_addReference(this->m_server,
-			methNodeId,
-			UA_NODEID_NUMERIC(0, UA_NS0ID_HASMODELLINGRULE),
-			UA_EXPANDEDNODEID_NUMERIC(0, UA_NS0ID_MODELLINGRULE_MANDATORY),
-			true);
-		Q_ASSERT(st == UA_STATUSCODE_GOOD);
-		Q_UNUSED(st);
+			outputArgument);
 		// store method with node id hash as key
 		Q_ASSERT_X(!m_hashMethods.contains(methNodeId),
 			"QUaServer::addMetaMethods",
 			"Method already exists, callback will be overwritten.");
-		m_hashMethods[methNodeId] = [i, this](void* objectContext, const UA_Variant* input, UA_Variant* output) {
+		// analyse signature once, callback only converts arguments and calls
+		QUaMetaMethodInvoker invoker;
+		invoker.methodIndex = i;
+		// NOTE : enums are QMetaType::UnknownType, called as int
+		invoker.returnType = metamethod.returnType() == QMetaType::UnknownType ?
+			QMetaType::Int : metamethod.returnType();
+		for (int k = 0; k < metamethod.parameterCount(); k++)
+		{
+			int argType = metamethod.parameterType(k);
+			Q_ASSERT_X(argType != QMetaType::UnknownType ||
+				this->m_hashEnums.contains(listTypeNames[k]),
+				"QUaServer::addMetaMethods",
+				"Argumant type is not registered. Try using qRegisterMetaType.");
+			auto argKind = QUaMetaMethodInvoker::ArgKind::Scalar;
+			if (listTypeNames[k].startsWith("QList"))
+			{
+				argKind = QUaMetaMethodInvoker::ArgKind::QList;
+			}
+			else if (listTypeNames[k].startsWith("QVector"))
+			{
+				argKind = QUaMetaMethodInvoker::ArgKind::QVector;
+			}
+			invoker.argTypes.append(argType == QMetaType::UnknownType ? QMetaType::Int : argType);
+			invoker.argKinds.append(argKind);
+		}
+		m_hashMethods[methNodeId] = [invoker](void* objectContext, const UA_Variant* input, UA_Variant* output) {
 			// get object instance that owns method
 			QUaBaseObject* object = qobject_cast<QUaBaseObject*>(static_cast<QObject*>(objectContext));
 			Q_ASSERT_X(object,
@@ -1782,93 +2664,7 @@ void QUaServer::addMetaMethods(const QMetaObject& parentMetaObject)
 			{
 				return (UA_StatusCode)UA_STATUSCODE_BADUNEXPECTEDERROR;
 			}
-			// NOTE : had to cache the method's index in lambda capture because caching metamethod directly was not working
-			//        in some cases the internal data of the metamethod was deleted which resulted in access violation
-			auto metamethod = object->metaObject()->method(i);
-			// convert input arguments to QVariants
-			QVariantList varListArgs;
-			QList<QGenericArgument> genListArgs;
-			auto listTypeNames = metamethod.parameterTypes();
-			for (int k = 0; k < metamethod.parameterCount(); k++)
-			{
-				QVariant varArg;
-				auto metaType = (QMetaType::Type)metamethod.parameterType(k);
-				auto strTypeName = QString(listTypeNames.at(k));
-				// NOTE : enums are QMetaType::UnknownType
-				Q_ASSERT_X(metaType != QMetaType::UnknownType ||
-					this->m_hashEnums.contains(strTypeName),
-					"QUaServer::addMetaMethods",
-					"Argumant type is not registered. Try using qRegisterMetaType.");
-				if (metaType == QMetaType::UnknownType &&
-					!this->m_hashEnums.contains(strTypeName))
-				{
-					return (UA_StatusCode)UA_STATUSCODE_BADINTERNALERROR;
-				}
-				if (strTypeName.contains("QList", Qt::CaseInsensitive))
-				{
-					varArg = QUaTypesConverter::uaVariantToQVariantArray(input[k],
-						QUaTypesConverter::ArrayType::QList);
-				}
-				else if (strTypeName.contains("QVector", Qt::CaseInsensitive))
-				{
-					varArg = QUaTypesConverter::uaVariantToQVariantArray(input[k],
-						QUaTypesConverter::ArrayType::QVector);
-				}
-				else
-				{
-					varArg = QUaTypesConverter::uaVariantToQVariant(input[k]);
-				}
-				// NOTE : need to keep in stack while method is being called
-				varListArgs.append(varArg);
-				// create generic argument only with reference to data
-				genListArgs.append(QGenericArgument(
-					QMetaType::typeName(varListArgs[k].userType()),
-					const_cast<void*>(varListArgs[k].constData())
-				));
-			}
-			// create return QVariant
-			int retType = metamethod.returnType();
-			// NOTE : enums are QMetaType::UnknownType
-			Q_ASSERT_X(retType != QMetaType::UnknownType ||
-				this->m_hashEnums.contains(metamethod.typeName()),
-				"QUaServer::addMetaMethods",
-				"Return type is not registered. Try using qRegisterMetaType.");
-			if (retType == QMetaType::UnknownType)
-			{
-				return (UA_StatusCode)UA_STATUSCODE_BADINTERNALERROR;
-			}
-			QVariant returnValue(retType, static_cast<void*>(NULL));
-			QGenericReturnArgument returnArgument(
-				metamethod.typeName(),
-				const_cast<void*>(returnValue.constData())
-			);
-			// call metamethod
-			bool ok = metamethod.invoke(
-				object,
-				Qt::DirectConnection,
-				returnArgument,
-				genListArgs.value(0),
-				genListArgs.value(1),
-				genListArgs.value(2),
-				genListArgs.value(3),
-				genListArgs.value(4),
-				genListArgs.value(5),
-				genListArgs.value(6),
-				genListArgs.value(7),
-				genListArgs.value(8),
-				genListArgs.value(9)
-			);
-			Q_ASSERT(ok);
-			Q_UNUSED(ok);
-			// set return value if any
-			if (retType != QMetaType::Void)
-			{
-				UA_Variant tmpVar = QUaTypesConverter::uaVariantFromQVariant(returnValue);
-				// TODO : cleanup? UA_Variant_deleteMembers(&tmpVar)
-				*output = tmpVar;
-			}
-			// return success status
-			return (UA_StatusCode)UA_STATUSCODE_GOOD;
+			return invoker(object, input, output);
 		};
 	}
 }
@@ -1902,9 +2698,7 @@ UA_NodeId QUaServer::createInstance(const QMetaObject& metaObject, QUaNode* pare
 	// adapt parent relation with child according to parent type
 	UA_NodeId referenceTypeId = QUaServer::getReferenceTypeId(*parentNode->metaObject(), metaObject);
 	// set qualified name, default is class name
-	UA_QualifiedName browseName;
-	browseName.namespaceIndex = 1;
-	browseName.name = QUaTypesConverter::uaStringFromQString(metaObject.className());
+	UA_QualifiedName browseName = QUaTypesConverter::uaQualifiedNameFromQString(metaObject.className());
 	// check if requested node id defined
 	QString strReqNodeId = strNodeId.trimmed();
 	UA_NodeId reqNodeId = UA_NODEID_NULL;
@@ -1975,11 +2769,11 @@ UA_NodeId QUaServer::createInstance(const QMetaObject& metaObject, QUaNode* pare
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
 	Q_CHECK_PTR(m_changeEvent);
 	// add reference added change to buffer
-	this->addChange({
-		parentNode->nodeId(),
-		parentNode->typeDefinitionNodeId(),
+	this->addChange(
+		parentNode,
+		QUaTypesConverter::nodeIdToQString(nodeIdNewInstance),
 		QUaChangeVerb::ReferenceAdded // UaExpert does not recognize QUaChangeVerb::NodeAdded
-		});
+	);
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 
 	// return new instance node id
@@ -2017,45 +2811,335 @@ UA_NodeId QUaServer::createEvent(const QMetaObject& metaObject, const UA_NodeId&
 	return nodeIdNewEvent;
 }
 
-#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
-
-void QUaServer::bindCppInstanceWithUaNode(QUaNode* nodeInstance, UA_NodeId& nodeId)
+void QUaServer::triggerEvent(const QMetaObject& metaObject, QUaNode* sourceNode, const QVariantMap& fields, const QStringList* defaultProperties)
 {
-	Q_CHECK_PTR(nodeInstance);
-	Q_ASSERT(!UA_NodeId_isNull(&nodeId));
-	// set c++ instance as context
-	UA_Server_setNodeContext(m_server, nodeId, (void**)(&nodeInstance));
-	// set node id to c++ instance
-	nodeInstance->m_nodeId = nodeId;
+	// NOTE : open62541 can only trigger events from an event node, so instead of creating
+	//        a node per event, a single event node per type is created and reused
+	QString strClassName = QString(metaObject.className());
+	auto iterTemplate = m_hashEventTemplates.find(strClassName);
+	if (iterTemplate == m_hashEventTemplates.end())
+	{
+		UA_NodeId nodeIdEvent = this->createEvent(metaObject, UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER), defaultProperties);
+		if (UA_NodeId_isNull(&nodeIdEvent))
+		{
+			return;
+		}
+		auto event = qobject_cast<QUaBaseEvent*>(QUaNode::getNodeContext(nodeIdEvent, this));
+		Q_CHECK_PTR(event);
+		// resolve fields once
+		QUaEventTemplate eventTemplate;
+		eventTemplate.nodeId = nodeIdEvent;
+		eventTemplate.event  = event;
+		for (auto field : event->findChildren<QUaBaseVariable*>(QString(), Qt::FindDirectChildrenOnly))
+		{
+			eventTemplate.fields.insert(field->objectName(), field);
+			eventTemplate.types.insert(field->objectName(), field->dataTypeInternal());
+			UA_Variant defaultValue;
+			auto st = UA_Server_readValue(m_server, field->m_nodeId, &defaultValue);
+			Q_ASSERT(st == UA_STATUSCODE_GOOD);
+			if (st == UA_STATUSCODE_GOOD)
+			{
+				eventTemplate.defaults.insert(field->objectName(), defaultValue);
+			}
+		}
+		iterTemplate = m_hashEventTemplates.insert(strClassName, eventTemplate);
+	}
+	// drop if over the rate limit of its source or type
+	if (this->eventRateLimited() && 
+		!this->admitEvent(sourceNode, metaObject, static_cast<quint16>(fields.value("Severity").toUInt())))
+	{
+		return;
+	}
+	QUaEventTemplate& eventTemplate = iterTemplate.value();
+	// write a single field, avoid emitting valueChanged
+	auto writeUaField = [this](QUaBaseVariable* field, const UA_Variant& uaValue) {
+		field->m_bInternalWrite = true;
+		auto st = UA_Server_writeValue(m_server, field->m_nodeId, uaValue);
+		Q_ASSERT(st == UA_STATUSCODE_GOOD);
+		if (st != UA_STATUSCODE_GOOD)
+		{
+			field->m_bInternalWrite = false;
+		}
+	};
+	QSet<QString> setWritten;
+	auto writeField = [&eventTemplate, &writeUaField, &setWritten](const QString& strName, const QVariant& value) {
+		QUaBaseVariable* field = eventTemplate.fields.value(strName, nullptr);
+		if (!field)
+		{
+			return;
+		}
+		QMetaType::Type type = eventTemplate.types.value(strName, QMetaType::UnknownType);
+		if (type == QMetaType::UnknownType)
+		{
+			type = (QMetaType::Type)value.type();
+		}
+		UA_Variant uaValue = QUaTypesConverter::uaVariantFromQVariant(value, type);
+		writeUaField(field, uaValue);
+		UA_Variant_clear(&uaValue);
+		setWritten.insert(strName);
+	};
+	// write fields
+	for (auto iter = fields.cbegin(); iter != fields.cend(); ++iter)
+	{
+		writeField(iter.key(), iter.value());
+	}
+	if (!fields.contains("Time"))
+	{
+		writeField("Time", QDateTime::currentDateTimeUtc());
+	}
+	if (!fields.contains("SourceName") && sourceNode)
+	{
+		writeField("SourceName", sourceNode->browseName());
+	}
+	// restore fields written by a previous trigger but not by this one, so they do not leak
+	for (auto strName : eventTemplate.written)
+	{
+		if (setWritten.contains(strName) || !eventTemplate.defaults.contains(strName))
+		{
+			continue;
+		}
+		writeUaField(eventTemplate.fields.value(strName), eventTemplate.defaults[strName]);
+	}
+	eventTemplate.written = setWritten;
+	// trigger, fields are copied to the notifications at this point so the node can be reused
+	UA_NodeId nodeIdOriginator = sourceNode ? sourceNode->m_nodeId : UA_NODEID_NUMERIC(0, UA_NS0ID_SERVER);
+	auto st = UA_Server_triggerEvent(
+		m_server,
+		eventTemplate.nodeId, // nodeId if the event
+		nodeIdOriginator,     // originating node
+		NULL,                 // the EventId of the new event
+		false                 // (do not) delete event node
+	);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+#ifdef UA_ENABLE_HISTORIZING
+	if (m_eventHistorizing && st == UA_STATUSCODE_GOOD)
+	{
+		this->historizeEvent(eventTemplate.event, nodeIdOriginator);
+	}
+#endif // UA_ENABLE_HISTORIZING
 }
 
-bool QUaServer::isMetaObjectRegistered(const QString& strClassName) const
+void QUaServer::setEventRateLimit(QUaNode* sourceNode, const double& maxEventsPerSecond, const quint32& suppressionWindowMs/* = 1000*/)
 {
-	return m_hashMetaObjects.contains(strClassName);
+	if (maxEventsPerSecond <= 0)
+	{
+		auto iter = m_hashSourceEventThrottles.find(sourceNode);
+		if (iter != m_hashSourceEventThrottles.end())
+		{
+			this->endEventSuppression(iter.value());
+			m_hashSourceEventThrottles.erase(iter);
+		}
+		return;
+	}
+	// remove limit when source is deleted
+	if (sourceNode && !m_hashSourceEventThrottles.contains(sourceNode))
+	{
+		QObject::connect(sourceNode, &QObject::destroyed, this,
+		[this, sourceNode]() {
+			m_hashSourceEventThrottles.remove(sourceNode);
+		});
+	}
+	// flush the window of the replaced limit
+	if (m_hashSourceEventThrottles.contains(sourceNode))
+	{
+		this->endEventSuppression(m_hashSourceEventThrottles[sourceNode]);
+	}
+	m_hashSourceEventThrottles[sourceNode] = QUaServer::newEventThrottle(maxEventsPerSecond, suppressionWindowMs, m_rateTimer.nsecsElapsed());
 }
 
-QMetaObject QUaServer::getRegisteredMetaObject(const QString& strClassName) const
+void QUaServer::setEventTypeRateLimit(const QString& strClassName, const double& maxEventsPerSecond, const quint32& suppressionWindowMs)
 {
-	Q_ASSERT_X(m_hashMetaObjects.contains(strClassName), "QUaServer::getRegisteredMetaObject", "Class is not registered.");
-	return m_hashMetaObjects.value(strClassName);
+	if (maxEventsPerSecond <= 0)
+	{
+		auto iter = m_hashTypeEventThrottles.find(strClassName);
+		if (iter != m_hashTypeEventThrottles.end())
+		{
+			this->endEventSuppression(iter.value());
+			m_hashTypeEventThrottles.erase(iter);
+		}
+		return;
+	}
+	// flush the window of the replaced limit
+	if (m_hashTypeEventThrottles.contains(strClassName))
+	{
+		this->endEventSuppression(m_hashTypeEventThrottles[strClassName]);
+	}
+	m_hashTypeEventThrottles[strClassName] = QUaServer::newEventThrottle(maxEventsPerSecond, suppressionWindowMs, m_rateTimer.nsecsElapsed());
 }
 
-void QUaServer::registerEnum(const QString& strEnumName, const QUaEnumMap& enumMap, const QString& strNodeId)
+void QUaServer::clearEventRateLimits()
 {
-	// check if already exists
-	if (m_hashEnums.contains(strEnumName))
+	for (auto& throttle : m_hashSourceEventThrottles)
 	{
-		return;
+		this->endEventSuppression(throttle);
 	}
-	// get c-compatible name
-	QByteArray byteEnumName = strEnumName.toUtf8();
-	char* charEnumName = byteEnumName.data();
-	// register enum as new ua data type
-	UA_DataTypeAttributes ddaatt = UA_DataTypeAttributes_default;
-	ddaatt.description = UA_LOCALIZEDTEXT((char*)(""), charEnumName);
-	ddaatt.displayName = UA_LOCALIZEDTEXT((char*)(""), charEnumName);
+	for (auto& throttle : m_hashTypeEventThrottles)
+	{
+		this->endEventSuppression(throttle);
+	}
+	m_hashSourceEventThrottles.clear();
+	m_hashTypeEventThrottles.clear();
+}
 
-	// check if requested node id defined
+quint64 QUaServer::suppressedEventCount() const
+{
+	return m_suppressedEventCount;
+}
+
+QUaServer::QUaEventThrottle QUaServer::newEventThrottle(const double& maxEventsPerSecond, const quint32& suppressionWindowMs, const qint64& now)
+{
+	QUaEventThrottle throttle;
+	throttle.limit               = QUaServer::validRateLimit(maxEventsPerSecond, 0);
+	throttle.suppressionWindowMs = qMax(1u, suppressionWindowMs);
+	throttle.tokens              = throttle.limit.burst;
+	throttle.lastRefill          = now;
+	throttle.suppressing         = false;
+	throttle.window              = 0;
+	throttle.suppressedCount     = 0;
+	throttle.maxSeverity         = 0;
+	return throttle;
+}
+
+bool QUaServer::eventRateLimited() const
+{
+	return !m_hashSourceEventThrottles.isEmpty() || !m_hashTypeEventThrottles.isEmpty();
+}
+
+bool QUaServer::admitEvent(QUaNode* sourceNode, const QMetaObject& metaObject, const quint16& severity)
+{
+	// summaries are never dropped
+	if (&metaObject == &QUaSuppressedEventsEvent::staticMetaObject)
+	{
+		return true;
+	}
+	// source limit takes precedence over type limit
+	QString strClassName = QString(metaObject.className());
+	QUaEventThrottle * throttle = nullptr;
+	std::function<void(quint64)> endWindow;
+	auto iterSource = m_hashSourceEventThrottles.find(sourceNode);
+	if (iterSource != m_hashSourceEventThrottles.end())
+	{
+		throttle  = &iterSource.value();
+		endWindow = [this, sourceNode](quint64 window) {
+			auto iter = m_hashSourceEventThrottles.find(sourceNode);
+			// throttle could have been replaced or its window already ended
+			if (iter != m_hashSourceEventThrottles.end() && iter.value().window == window)
+			{
+				this->endEventSuppression(iter.value());
+			}
+		};
+	}
+	else
+	{
+		auto iterType = m_hashTypeEventThrottles.find(strClassName);
+		if (iterType == m_hashTypeEventThrottles.end())
+		{
+			return true;
+		}
+		throttle  = &iterType.value();
+		endWindow = [this, strClassName](quint64 window) {
+			auto iter = m_hashTypeEventThrottles.find(strClassName);
+			// throttle could have been replaced or its window already ended
+			if (iter != m_hashTypeEventThrottles.end() && iter.value().window == window)
+			{
+				this->endEventSuppression(iter.value());
+			}
+		};
+	}
+	// refill
+	qint64 now = m_rateTimer.nsecsElapsed();
+	throttle->tokens = qMin(throttle->limit.burst,
+		throttle->tokens + static_cast<double>(now - throttle->lastRefill) * throttle->limit.ratePerSecond / 1e9);
+	throttle->lastRefill = now;
+	if (!throttle->suppressing && throttle->tokens >= 1.0)
+	{
+		throttle->tokens -= 1.0;
+		return true;
+	}
+	// open suppression window, repeats are merged into a single summary when it ends
+	if (!throttle->suppressing)
+	{
+		throttle->suppressing     = true;
+		throttle->suppressedCount = 0;
+		throttle->maxSeverity     = 0;
+		throttle->window          = ++m_suppressionWindowCount;
+		quint64 window            = throttle->window;
+		QTimer::singleShot(static_cast<int>(throttle->suppressionWindowMs), this, [endWindow, window]() {
+			endWindow(window);
+		});
+	}
+	throttle->suppressedCount++;
+	throttle->maxSeverity       = qMax(throttle->maxSeverity, severity);
+	throttle->strSuppressedType = strClassName;
+	throttle->lastSource        = sourceNode;
+	m_suppressedEventCount++;
+	return false;
+}
+
+void QUaServer::endEventSuppression(QUaEventThrottle& throttle)
+{
+	if (!throttle.suppressing)
+	{
+		return;
+	}
+	throttle.suppressing = false;
+	if (throttle.suppressedCount == 0)
+	{
+		return;
+	}
+	// copy before triggering, summary is triggered from the last suppressed source
+	QUaNode * sourceNode = throttle.lastSource.data();
+	QVariantMap fields;
+	fields["suppressedCount"    ] = throttle.suppressedCount;
+	fields["suppressedEventType"] = throttle.strSuppressedType;
+	fields["Severity"           ] = throttle.maxSeverity;
+	fields["Message"            ] = QString("%1 events of type %2 suppressed.")
+		.arg(throttle.suppressedCount)
+		.arg(throttle.strSuppressedType);
+	throttle.suppressedCount = 0;
+	this->triggerEvent<QUaSuppressedEventsEvent>(sourceNode, fields);
+}
+
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
+void QUaServer::bindCppInstanceWithUaNode(QUaNode* nodeInstance, UA_NodeId& nodeId)
+{
+	Q_CHECK_PTR(nodeInstance);
+	Q_ASSERT(!UA_NodeId_isNull(&nodeId));
+	// set c++ instance as context
+	UA_Server_setNodeContext(m_server, nodeId, (void**)(&nodeInstance));
+	// set node id to c++ instance
+	nodeInstance->m_nodeId = nodeId;
+}
+
+bool QUaServer::isMetaObjectRegistered(const QString& strClassName) const
+{
+	return m_hashMetaObjects.contains(strClassName);
+}
+
+QMetaObject QUaServer::getRegisteredMetaObject(const QString& strClassName) const
+{
+	Q_ASSERT_X(m_hashMetaObjects.contains(strClassName), "QUaServer::getRegisteredMetaObject", "Class is not registered.");
+	return m_hashMetaObjects.value(strClassName);
+}
+
+void QUaServer::registerEnum(const QString& strEnumName, const QUaEnumMap& enumMap, const QString& strNodeId)
+{
+	// check if already exists
+	if (m_hashEnums.contains(strEnumName))
+	{
+		return;
+	}
+	// get c-compatible name
+	QByteArray byteEnumName = strEnumName.toUtf8();
+	char* charEnumName = byteEnumName.data();
+	// register enum as new ua data type
+	UA_DataTypeAttributes ddaatt = UA_DataTypeAttributes_default;
+	ddaatt.description = UA_LOCALIZEDTEXT((char*)(""), charEnumName);
+	ddaatt.displayName = UA_LOCALIZEDTEXT((char*)(""), charEnumName);
+
+	// check if requested node id defined
 	QString strReqNodeId = strNodeId.trimmed();
 	UA_NodeId reqNodeId = strReqNodeId.isEmpty() ? UA_NODEID_NULL : QUaTypesConverter::nodeIdFromQString(strReqNodeId);
 	// check if requested node id exists
@@ -2300,9 +3384,7 @@ bool QUaServer::registerReferenceType(const QUaReferenceType &refType, const QSt
 	// get namea and stuff
 	QByteArray byteForwardName = refType.strForwardName.toUtf8();
 	QByteArray byteInverseName = refType.strInverseName.toUtf8();
-	UA_QualifiedName browseName;
-	browseName.namespaceIndex = 1;
-	browseName.name = QUaTypesConverter::uaStringFromQString(refType.strForwardName);
+	UA_QualifiedName browseName = QUaTypesConverter::uaQualifiedNameFromQString(refType.strForwardName);
 	// setup new ref type attributes
 	UA_ReferenceTypeAttributes refattr = UA_ReferenceTypeAttributes_default;
 	refattr.displayName = UA_LOCALIZEDTEXT((char*)(""), byteForwardName.data());
@@ -2407,7 +3489,20 @@ void QUaServer::addUser(const QString & strUserName, const QString & strKey)
 	{
 		return;
 	}
-	m_hashUsers[strUserName] = strKey;
+	this->addUserHash(strUserName, QUaServer::hashKey(strKey, m_keyHashIterations));
+}
+
+void QUaServer::addUserHash(const QString & strUserName, const QString & strKeyHash)
+{
+	if (strUserName.isEmpty())
+	{
+		return;
+	}
+	m_hashUsers[strUserName] = strKeyHash;
+	// old password no longer valid
+	m_hashLoginCache.remove(strUserName);
+	// user might be new
+	this->clearPermissionsCache();
 }
 
 void QUaServer::removeUser(const QString & strUserName)
@@ -2417,6 +3512,11 @@ void QUaServer::removeUser(const QString & strUserName)
 		return;
 	}
 	m_hashUsers.remove(strUserName);
+	m_hashLoginCache.remove(strUserName);
+	// user re-added with the same name must not inherit old roles
+	m_hashUserRoles.remove(strUserName);
+	// sessions of removed user lose all permissions
+	this->clearPermissionsCache();
 }
 
 QString QUaServer::userKey(const QString & strUserName) const
@@ -2424,6 +3524,182 @@ QString QUaServer::userKey(const QString & strUserName) const
 	return m_hashUsers.value(strUserName, QString());
 }
 
+bool QUaServer::verifyUserKey(const QString & strUserName, const QString & strKey) const
+{
+	if (!m_hashUsers.contains(strUserName))
+	{
+		return false;
+	}
+	return QUaServer::verifyKey(m_hashUsers[strUserName], strKey);
+}
+
+int QUaServer::keyHashIterations() const
+{
+	return m_keyHashIterations;
+}
+
+void QUaServer::setKeyHashIterations(const int & iterations)
+{
+	Q_ASSERT(iterations > 0);
+	// NOTE : existing hashes keep their own iterations
+	m_keyHashIterations = qMax(1, iterations);
+}
+
+int QUaServer::loginCacheTimeout() const
+{
+	return m_loginCacheTimeout;
+}
+
+void QUaServer::setLoginCacheTimeout(const int & timeoutMs)
+{
+	m_loginCacheTimeout = qMax(0, timeoutMs);
+	m_hashLoginCache.clear();
+}
+
+QByteArray QUaServer::loginDigest(const QString & strUserName, const QString & strPassword) const
+{
+	// NOTE : cheap keyed digest, the random secret never leaves this instance
+	QMessageAuthenticationCode mac(QCryptographicHash::Sha256, m_loginCacheSecret);
+	mac.addData(strUserName.toUtf8());
+	mac.addData(QByteArray(1, '\0'));
+	mac.addData(strPassword.toUtf8());
+	return mac.result();
+}
+
+bool QUaServer::validateLogin(const QString & strUserName, const QString & strPassword)
+{
+	const qint64 now = QDateTime::currentMSecsSinceEpoch();
+	QByteArray digest;
+	if (m_loginCacheTimeout > 0)
+	{
+		digest = this->loginDigest(strUserName, strPassword);
+		auto iter = m_hashLoginCache.find(strUserName);
+		if (iter != m_hashLoginCache.end())
+		{
+			if (iter.value().expiry <= now)
+			{
+				m_hashLoginCache.erase(iter);
+			}
+			else if (iter.value().digest == digest)
+			{
+				return true;
+			}
+			// NOTE : a wrong password must not evict the valid login of the user
+		}
+	}
+	// reject without validation while backing off
+	auto iterBackoff = m_hashLoginBackoff.find(strUserName);
+	if (iterBackoff != m_hashLoginBackoff.end() && iterBackoff.value().blockedUntil > now)
+	{
+		return false;
+	}
+	// full validation
+	if (!m_validationCallback(strUserName, strPassword))
+	{
+		this->addLoginFailure(strUserName, now);
+		return false;
+	}
+	m_hashLoginBackoff.remove(strUserName);
+	if (m_loginCacheTimeout > 0)
+	{
+		m_hashLoginCache.insert(strUserName, { digest, now + m_loginCacheTimeout });
+	}
+	return true;
+}
+
+void QUaServer::addLoginFailure(const QString & strUserName, const qint64 & now)
+{
+	// bound memory when many user names are tried, forget the ones no longer blocked
+	if (m_hashLoginBackoff.size() >= QUA_LOGIN_BACKOFF_MAX_USERS && !m_hashLoginBackoff.contains(strUserName))
+	{
+		for (auto iter = m_hashLoginBackoff.begin(); iter != m_hashLoginBackoff.end();)
+		{
+			iter = iter.value().blockedUntil <= now ? m_hashLoginBackoff.erase(iter) : iter + 1;
+		}
+	}
+	QUaLoginBackoff &backoff = m_hashLoginBackoff[strUserName];
+	backoff.failures = qMin(backoff.failures + 1, 31u);
+	const qint64 delay = qMin(static_cast<qint64>(QUA_LOGIN_BACKOFF_BASE_MS) << (backoff.failures - 1),
+		static_cast<qint64>(QUA_LOGIN_BACKOFF_MAX_MS));
+	backoff.blockedUntil = now + delay;
+}
+
+// PBKDF2-HMAC-SHA256, single 32 byte block (RFC 8018)
+static QByteArray QUaPbkdf2Sha256(const QByteArray &key, const QByteArray &salt, const int &iterations)
+{
+	QMessageAuthenticationCode mac(QCryptographicHash::Sha256, key);
+	mac.addData(salt);
+	mac.addData(QByteArray::fromHex("00000001"));
+	QByteArray u    = mac.result();
+	QByteArray hash = u;
+	for (int i = 1; i < iterations; i++)
+	{
+		mac.reset();
+		mac.addData(u);
+		u = mac.result();
+		for (int j = 0; j < hash.size(); j++)
+		{
+			hash[j] = hash.at(j) ^ u.at(j);
+		}
+	}
+	return hash;
+}
+
+QByteArray QUaServer::randomBytes(const int & size)
+{
+	// NOTE : std::random_device instead of QRandomGenerator (Qt 5.10) to keep supporting Qt 5.7,
+	//        it reads from the OS entropy source on all supported platforms
+	std::random_device device;
+	QByteArray bytes(size, 0);
+	for (int i = 0; i < size; i++)
+	{
+		bytes[i] = static_cast<char>(device() & 0xFF);
+	}
+	return bytes;
+}
+
+QString QUaServer::hashKey(const QString & strKey, const int & iterations)
+{
+	// random salt
+	const QByteArray salt = QUaServer::randomBytes(16);
+	const QByteArray hash = QUaPbkdf2Sha256(strKey.toUtf8(), salt, iterations);
+	// format : pbkdf2-sha256:iterations:salt:hash
+	return QString("pbkdf2-sha256:%1:%2:%3")
+		.arg(iterations)
+		.arg(QString::fromLatin1(salt.toBase64()))
+		.arg(QString::fromLatin1(hash.toBase64()));
+}
+
+bool QUaServer::verifyKey(const QString & strKeyHash, const QString & strKey)
+{
+	const QStringList parts = strKeyHash.split(':');
+	if (parts.count() != 4 || parts.at(0) != QLatin1String("pbkdf2-sha256"))
+	{
+		return false;
+	}
+	bool ok = false;
+	const int iterations = parts.at(1).toInt(&ok);
+	if (!ok || iterations <= 0)
+	{
+		return false;
+	}
+	const QByteArray salt     = QByteArray::fromBase64(parts.at(2).toLatin1());
+	const QByteArray expected = QByteArray::fromBase64(parts.at(3).toLatin1());
+	// recompute
+	const QByteArray hash = QUaPbkdf2Sha256(strKey.toUtf8(), salt, iterations);
+	if (hash.size() != expected.size())
+	{
+		return false;
+	}
+	// constant time compare
+	char diff = 0;
+	for (int j = 0; j < hash.size(); j++)
+	{
+		diff |= hash.at(j) ^ expected.at(j);
+	}
+	return diff == 0;
+}
+
 int QUaServer::userCount()
 {
 	return m_hashUsers.count();
@@ -2443,6 +3719,357 @@ bool QUaServer::userExists(const QString & strUserName) const
 	return m_hashUsers.contains(strUserName);
 }
 
+void QUaServer::clearPermissionsCache()
+{
+	// NOTE : lazy, each session clears its cache on its next access check
+	m_permissionsVersion++;
+	// skip 0, reserved to force refresh
+	if (m_permissionsVersion == 0)
+	{
+		m_permissionsVersion++;
+	}
+}
+
+bool QUaServer::addRole(const QString & strRole)
+{
+	if (strRole.isEmpty() || this->roleExists(strRole))
+	{
+		return false;
+	}
+	// reuse free slot if any
+	int index = m_roles.indexOf(QString());
+	if (index < 0)
+	{
+		if (m_roles.count() >= QUA_MAX_ROLES)
+		{
+			return false;
+		}
+		index = m_roles.count();
+		m_roles.append(QString());
+	}
+	m_roles[index] = strRole;
+	// first role enables role based access
+	this->rolesChanged();
+	return true;
+}
+
+void QUaServer::removeRole(const QString & strRole)
+{
+	int index = this->roleIndex(strRole);
+	if (index < 0)
+	{
+		return;
+	}
+	const quint64 mask = ~(Q_UINT64_C(1) << index);
+	for (auto iter = m_hashUserRoles.begin(); iter != m_hashUserRoles.end(); ++iter)
+	{
+		iter.value() &= mask;
+	}
+	for (auto node : m_roleRuleNodes)
+	{
+		for (int i = 0; i < QUA_PERMISSIONS_COUNT; i++)
+		{
+			node->m_roleGrants[i] &= mask;
+			node->m_roleDenies[i] &= mask;
+		}
+	}
+	// free slot, trailing free slots are dropped so no roles means empty
+	m_roles[index] = QString();
+	while (!m_roles.isEmpty() && m_roles.last().isEmpty())
+	{
+		m_roles.removeLast();
+	}
+	this->rolesChanged();
+}
+
+QStringList QUaServer::roleNames() const
+{
+	QStringList retList;
+	for (auto strRole : m_roles)
+	{
+		if (!strRole.isEmpty())
+		{
+			retList << strRole;
+		}
+	}
+	return retList;
+}
+
+bool QUaServer::roleExists(const QString & strRole) const
+{
+	return this->roleIndex(strRole) >= 0;
+}
+
+void QUaServer::setUserRoles(const QString & strUserName, const QStringList & roles)
+{
+	quint64 userRoles = 0;
+	for (auto strRole : roles)
+	{
+		int index = this->roleIndex(strRole);
+		Q_ASSERT_X(index >= 0, "QUaServer::setUserRoles", "Role does not exist.");
+		if (index < 0)
+		{
+			continue;
+		}
+		userRoles |= Q_UINT64_C(1) << index;
+	}
+	m_hashUserRoles[strUserName] = userRoles;
+	this->clearPermissionsCache();
+}
+
+QStringList QUaServer::userRoles(const QString & strUserName) const
+{
+	QStringList retList;
+	quint64 userRoles = m_hashUserRoles.value(strUserName, 0);
+	for (int i = 0; i < m_roles.count(); i++)
+	{
+		if (userRoles & (Q_UINT64_C(1) << i))
+		{
+			retList << m_roles.at(i);
+		}
+	}
+	return retList;
+}
+
+void QUaServer::grantPermissions(const QString & strRole, QUaNode * node, const QUaPermissions & permissions)
+{
+	this->setRoleRules(strRole, node, permissions, permissions, QUaPermissions());
+}
+
+void QUaServer::denyPermissions(const QString & strRole, QUaNode * node, const QUaPermissions & permissions)
+{
+	this->setRoleRules(strRole, node, permissions, QUaPermissions(), permissions);
+}
+
+void QUaServer::clearPermissions(const QString & strRole, QUaNode * node)
+{
+	// neither grant nor deny any permission
+	const quint8 all = (1 << QUA_PERMISSIONS_COUNT) - 1;
+	this->setRoleRules(strRole, node, QUaPermissions(all), QUaPermissions(), QUaPermissions());
+}
+
+QUaPermissions QUaServer::userPermissions(const QString & strUserName, QUaNode * node)
+{
+	Q_CHECK_PTR(node);
+	// no roles, no restrictions
+	if (m_roles.isEmpty() || !node)
+	{
+		return QUaPermissions((1 << QUA_PERMISSIONS_COUNT) - 1);
+	}
+	const quint64 userRoles = m_hashUserRoles.value(strUserName, 0);
+	if (!userRoles)
+	{
+		return QUaPermissions();
+	}
+	// bit test per permission
+	const quint64 * masks = node->roleMasks();
+	QUaPermissions permissions;
+	for (int i = 0; i < QUA_PERMISSIONS_COUNT; i++)
+	{
+		if (masks[i] & userRoles)
+		{
+			permissions.intValue |= (1 << i);
+		}
+	}
+	return permissions;
+}
+
+int QUaServer::roleIndex(const QString & strRole) const
+{
+	if (strRole.isEmpty())
+	{
+		return -1;
+	}
+	return m_roles.indexOf(strRole);
+}
+
+void QUaServer::setRoleRules(const QString & strRole, QUaNode * node, const QUaPermissions & permissions, const QUaPermissions & grants, const QUaPermissions & denies)
+{
+	Q_CHECK_PTR(node);
+	int index = this->roleIndex(strRole);
+	Q_ASSERT_X(index >= 0, "QUaServer::setRoleRules", "Role does not exist.");
+	if (index < 0 || !node)
+	{
+		return;
+	}
+	const quint64 bit = Q_UINT64_C(1) << index;
+	bool hasRules = false;
+	for (int i = 0; i < QUA_PERMISSIONS_COUNT; i++)
+	{
+		// latest call wins for the given permissions
+		if (permissions.intValue & (1 << i))
+		{
+			node->m_roleGrants[i] = (grants.intValue & (1 << i)) ? node->m_roleGrants[i] | bit : node->m_roleGrants[i] & ~bit;
+			node->m_roleDenies[i] = (denies.intValue & (1 << i)) ? node->m_roleDenies[i] | bit : node->m_roleDenies[i] & ~bit;
+		}
+		hasRules = hasRules || node->m_roleGrants[i] || node->m_roleDenies[i];
+	}
+	// keep track of nodes with rules, to be able to remove roles
+	if (hasRules)
+	{
+		m_roleRuleNodes.insert(node);
+	}
+	else
+	{
+		m_roleRuleNodes.remove(node);
+	}
+	this->rolesChanged();
+}
+
+void QUaServer::rolesChanged()
+{
+	// NOTE : lazy, each node recomputes its masks on its next access check
+	m_rolesVersion++;
+	if (m_rolesVersion == 0)
+	{
+		m_rolesVersion++;
+	}
+	this->clearPermissionsCache();
+}
+
+void QUaServer::setRequestRateLimit(const QUaSession::Service & service, const double & ratePerSecond, const double & burst/* = 0*/)
+{
+	if (service == QUaSession::Service::Read)
+	{
+		Q_ASSERT_X(false, "QUaServer::setRequestRateLimit", "Read requests cannot be limited.");
+		return;
+	}
+	m_rateLimits[static_cast<int>(service)] = QUaServer::validRateLimit(ratePerSecond, burst);
+	this->rateLimitsChanged();
+}
+
+QUaRateLimit QUaServer::requestRateLimit(const QUaSession::Service & service) const
+{
+	return m_rateLimits[static_cast<int>(service)];
+}
+
+void QUaServer::setUserRequestRateLimit(const QString & strUserName, const QUaSession::Service & service, const double & ratePerSecond, const double & burst/* = 0*/)
+{
+	if (service == QUaSession::Service::Read)
+	{
+		Q_ASSERT_X(false, "QUaServer::setUserRequestRateLimit", "Read requests cannot be limited.");
+		return;
+	}
+	// user starts with default limits
+	if (!m_hashUserRateLimits.contains(strUserName))
+	{
+		m_hashUserRateLimits.insert(strUserName, QVector<QUaRateLimit>(m_rateLimits, m_rateLimits + QUaSession::ServiceCount));
+	}
+	m_hashUserRateLimits[strUserName][static_cast<int>(service)] = QUaServer::validRateLimit(ratePerSecond, burst);
+	this->rateLimitsChanged();
+}
+
+QUaRateLimit QUaServer::userRequestRateLimit(const QString & strUserName, const QUaSession::Service & service) const
+{
+	auto iter = m_hashUserRateLimits.find(strUserName);
+	if (iter == m_hashUserRateLimits.end())
+	{
+		return m_rateLimits[static_cast<int>(service)];
+	}
+	return iter.value().at(static_cast<int>(service));
+}
+
+void QUaServer::clearUserRequestRateLimits(const QString & strUserName)
+{
+	if (m_hashUserRateLimits.remove(strUserName) == 0)
+	{
+		return;
+	}
+	this->rateLimitsChanged();
+}
+
+QUaRateLimit QUaServer::validRateLimit(const double & ratePerSecond, const double & burst)
+{
+	QUaRateLimit limit;
+	limit.ratePerSecond = qMax(0.0, ratePerSecond);
+	// at least one request must fit in the bucket
+	limit.burst = burst > 0 ? qMax(1.0, burst) : qMax(1.0, limit.ratePerSecond);
+	return limit;
+}
+
+void QUaServer::rateLimitsChanged()
+{
+	// NOTE : lazy, each session reloads its buckets on its next request
+	m_rateLimitsVersion++;
+	if (m_rateLimitsVersion == 0)
+	{
+		m_rateLimitsVersion++;
+	}
+}
+
+bool QUaServer::admitRequest(QUaSession * session, const QUaSession::Service & service)
+{
+	Q_CHECK_PTR(session);
+	qint64 now = m_rateTimer.nsecsElapsed();
+	// reload buckets if stale, full after reload
+	if (session->m_rateLimitsVersion != m_rateLimitsVersion)
+	{
+		auto iter = m_hashUserRateLimits.find(session->m_strUserName);
+		const QUaRateLimit * limits = iter == m_hashUserRateLimits.end() ?
+			m_rateLimits : iter.value().constData();
+		for (int i = 0; i < QUaSession::ServiceCount; i++)
+		{
+			QUaSession::QUaTokenBucket &bucket = session->m_buckets[i];
+			bucket.ratePerSecond = limits[i].ratePerSecond;
+			bucket.burst         = limits[i].burst;
+			bucket.tokens        = limits[i].burst;
+			bucket.lastRefill    = now;
+		}
+		session->m_rateLimitsVersion = m_rateLimitsVersion;
+	}
+	int index = static_cast<int>(service);
+	QUaSession::QUaTokenBucket &bucket = session->m_buckets[index];
+	if (bucket.ratePerSecond <= 0)
+	{
+		return true;
+	}
+	// refill
+	bucket.tokens = qMin(bucket.burst, 
+		bucket.tokens + static_cast<double>(now - bucket.lastRefill) * bucket.ratePerSecond / 1e9);
+	bucket.lastRefill = now;
+	if (bucket.tokens < 1.0)
+	{
+		++session->m_rejectedCount[index];
+		return false;
+	}
+	bucket.tokens -= 1.0;
+	return true;
+}
+
+QUaSession * QUaServer::getValidSession(const UA_NodeId & sessionId, void * sessionContext/* = nullptr*/)
+{
+	Q_ASSERT(m_hashSessions.contains(sessionId));
+	QUaSession * session = sessionContext ? 
+		static_cast<QUaSession*>(sessionContext) :
+		m_hashSessions.value(sessionId, nullptr);
+	Q_ASSERT(!sessionContext || m_hashSessions.value(sessionId, nullptr) == session);
+	if (!session)
+	{
+		return nullptr;
+	}
+	// first request since activation, session is now attached to the channel it came through
+	if (session->m_addressStale)
+	{
+		QUaServer::updateSessionAddress(session);
+		session->m_addressStale = false;
+	}
+	// refresh if stale
+	if (session->m_permissionsVersion != m_permissionsVersion)
+	{
+		session->m_hashUserWriteMask  .clear();
+		session->m_hashUserAccessLevel.clear();
+		session->m_hashUserExecutable .clear();
+		session->m_userValid = session->m_strUserName.isEmpty() || this->userExists(session->m_strUserName);
+		session->m_permissionsVersion = m_permissionsVersion;
+	}
+	return session->m_userValid ? session : nullptr;
+}
+
+QUaSession * QUaServer::sessionById(const UA_NodeId * sessionId) const
+{
+	return sessionId ? m_hashSessions.value(*sessionId, nullptr) : nullptr;
+}
+
 QList<const QUaSession*> QUaServer::sessions() const
 {
     QList<const QUaSession*> listConstSessions;
@@ -2487,7 +4114,21 @@ UA_NodeId QUaServer::getReferenceTypeId(const QMetaObject & parentMetaObject, co
 QUaSession::QUaSession(QObject* parent/* = 0*/)
 	: QObject(parent)
 {
-	m_timestamp = QDateTime::currentDateTimeUtc();
+	m_timestamp          = QDateTime::currentDateTimeUtc();
+	m_permissionsVersion = 0;
+	m_userValid          = false;
+	m_uaSession          = nullptr;
+	m_intPort            = 0;
+	m_addressStale       = false;
+	m_pendingCalls       = 0;
+	std::fill(m_requestCount, m_requestCount + ServiceCount, 0);
+	m_bytesReceived      = 0;
+	m_bytesSent          = 0;
+	m_monitoredItems     = 0;
+	m_latencyNSecs       = 0;
+	m_latencySamples     = 0;
+	std::fill(m_rejectedCount, m_rejectedCount + ServiceCount, 0);
+	m_rateLimitsVersion  = 0;
 }
 
 QString QUaSession::sessionId() const
@@ -2529,3 +4170,109 @@ QDateTime QUaSession::timestamp() const
 {
 	return m_timestamp;
 }
+
+quint64 QUaSession::requestCount(const Service & service) const
+{
+	return m_requestCount[static_cast<int>(service)];
+}
+
+quint64 QUaSession::bytesReceived() const
+{
+	return m_bytesReceived;
+}
+
+quint64 QUaSession::bytesSent() const
+{
+	return m_bytesSent;
+}
+
+quint32 QUaSession::monitoredItems() const
+{
+	return m_monitoredItems;
+}
+
+quint32 QUaSession::subscriptions() const
+{
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+	auto uaSession = static_cast<UA_Session*>(m_uaSession);
+	return uaSession ? uaSession->numSubscriptions : 0;
+#else
+	return 0;
+#endif // UA_ENABLE_SUBSCRIPTIONS
+}
+
+QDateTime QUaSession::lastActivity() const
+{
+	auto uaSession = static_cast<UA_Session*>(m_uaSession);
+	if (!uaSession)
+	{
+		return QDateTime();
+	}
+	// open62541 pushes validTill forward by the session timeout on every request
+	return QUaDateTime(uaSession->validTill - 
+		static_cast<UA_DateTime>(uaSession->timeout * UA_DATETIME_MSEC)).toDateTime();
+}
+
+double QUaSession::averageLatency() const
+{
+	if (m_latencySamples == 0)
+	{
+		return 0.0;
+	}
+	return static_cast<double>(m_latencyNSecs) / static_cast<double>(m_latencySamples) / 1000000.0;
+}
+
+quint64 QUaSession::rejectedCount(const Service & service) const
+{
+	return m_rejectedCount[static_cast<int>(service)];
+}
+
+double QUaSession::availableTokens(const Service & service) const
+{
+	// NOTE : buckets are only loaded once the session issues requests
+	const QUaTokenBucket &bucket = m_buckets[static_cast<int>(service)];
+	if (m_rateLimitsVersion == 0 || bucket.ratePerSecond <= 0)
+	{
+		return -1.0;
+	}
+	return bucket.tokens;
+}
+
+void QUaSession::addRequest(const Service & service, 
+	                        const qint64  & nsecs, 
+	                        const quint64 & bytesReceived/* = 0*/, 
+	                        const quint64 & bytesSent/* = 0*/)
+{
+	++m_requestCount[static_cast<int>(service)];
+	this->addTraffic(nsecs, bytesReceived, bytesSent);
+}
+
+void QUaSession::addCall(const qint64       & nsecs, 
+	                     const UA_Variant   * input, 
+	                     const size_t       & inputSize, 
+	                     const UA_Variant   * output, 
+	                     const size_t       & outputSize, 
+	                     const UA_StatusCode& status)
+{
+	quint64 bytesReceived = 0;
+	for (size_t i = 0; i < inputSize; i++)
+	{
+		bytesReceived += UA_calcSizeBinary(&input[i], &UA_TYPES[UA_TYPES_VARIANT]);
+	}
+	quint64 bytesSent = 0;
+	for (size_t i = 0; status == UA_STATUSCODE_GOOD && i < outputSize; i++)
+	{
+		bytesSent += UA_calcSizeBinary(&output[i], &UA_TYPES[UA_TYPES_VARIANT]);
+	}
+	this->addRequest(Service::Call, nsecs, bytesReceived, bytesSent);
+}
+
+void QUaSession::addTraffic(const qint64  & nsecs, 
+	                        const quint64 & bytesReceived, 
+	                        const quint64 & bytesSent)
+{
+	m_bytesReceived += bytesReceived;
+	m_bytesSent     += bytesSent;
+	m_latencyNSecs  += nsecs;
+	++m_latencySamples;
+}
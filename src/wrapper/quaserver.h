@@ -4,6 +4,8 @@
 #include <type_traits>
 
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QPointer>
 
 #include <QUaTypesConverter>
 #include <QUaFolderObject>
@@ -13,11 +15,31 @@
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
 #include <QUaBaseEvent>
 #include <QUaGeneralModelChangeEvent>
+#include <QUaSuppressedEventsEvent>
+#include <QUaMethodCompletedEvent>
 #include <QFunctionUtils>
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 #ifdef UA_ENABLE_HISTORIZING
 #include <QUaHistoryBackend>
 #endif // UA_ENABLE_HISTORIZING
+#include <QUaValueQueue>
+#include <QUaArrayView>
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+// open62541 internal, defined in quaserver_anex.h
+struct UA_MonitoredItem;
+#endif // UA_ENABLE_SUBSCRIPTIONS
+
+// default PBKDF2 iterations for user key hashes
+#define QUA_KEY_HASH_ITERATIONS 10000
+// default time (ms) a successful login is remembered
+#define QUA_LOGIN_CACHE_TIMEOUT 60000
+// delay (ms) after the first failed login of a user, doubled on every further failure
+#define QUA_LOGIN_BACKOFF_BASE_MS 100
+// maximum delay (ms) between failed logins of a user
+#define QUA_LOGIN_BACKOFF_MAX_MS 30000
+// maximum number of user names with failed logins being tracked
+#define QUA_LOGIN_BACKOFF_MAX_USERS 1024
 
 // Enum Stuff
 typedef qint64 QUaEnumKey;
@@ -47,9 +69,22 @@ signals:
 	void signalNewInstance(QUaNode *node);
 };
 
+// Request rate limit, token bucket refilled at ratePerSecond up to burst tokens
+// NOTE : ratePerSecond <= 0 means unlimited
+struct QUaRateLimit
+{
+	double ratePerSecond;
+	double burst;
+};
+
 class QUaSession : public QObject
 {
 	friend class QUaServer;
+	friend class QUaBaseVariable;
+	friend class QUaBaseObject;
+#ifdef UA_ENABLE_HISTORIZING
+	friend class QUaHistoryBackend;
+#endif // UA_ENABLE_HISTORIZING
 	Q_OBJECT
 
 	Q_PROPERTY(QString   sessionId       READ sessionId      )
@@ -74,6 +109,35 @@ public:
 	quint16   port           () const;
     QDateTime timestamp      () const;
 
+	// Traffic API
+
+	// services accounted per session
+	// NOTE : only requests that reach the server callbacks are counted
+	enum class Service
+	{
+		Read        = 0, // value attribute access checks for the session user, includes
+		                 // subscription sampling and write checks (no Read service hook in open62541 v1.0)
+		Write       = 1, // client writes to variable values
+		Call        = 2, // method calls
+		HistoryRead = 3  // historical data reads (one per continuation)
+	};
+	// number of services, size of the per service counters and limits
+	static constexpr int ServiceCount = static_cast<int>(Service::HistoryRead) + 1;
+
+	quint64   requestCount     (const Service &service) const;
+	// encoded size of values and arguments exchanged through the server callbacks
+	quint64   bytesReceived    () const;
+	quint64   bytesSent        () const;
+	quint32   monitoredItems   () const;
+	quint32   subscriptions    () const;
+	QDateTime lastActivity     () const;
+	// average time [ms] spent serving write, data source, method and history requests
+	double    averageLatency   () const;
+	// requests refused because the session exceeded its rate limit (see QUaServer Rate Limit API)
+	quint64   rejectedCount    (const Service &service) const;
+	// tokens currently available for the service, negative if unlimited
+	double    availableTokens  (const Service &service) const;
+
 private:
 	QString   m_strSessionId;
 	QString   m_strUserName;
@@ -82,7 +146,54 @@ private:
 	QString   m_strProductUri;
 	QString   m_strAddress;
 	quint16   m_intPort;
+	// peer address must be read again on the next request (see QUaServer::newSession)
+	bool      m_addressStale;
     QDateTime m_timestamp;
+	// effective permissions of the session user, cached per node
+	// NOTE : stale when m_permissionsVersion differs from the server's
+	quint32                     m_permissionsVersion;
+	bool                        m_userValid;
+	QHash<QUaNode*, UA_UInt32>  m_hashUserWriteMask;
+	QHash<QUaNode*, UA_Byte>    m_hashUserAccessLevel;
+	QHash<QUaNode*, UA_Boolean> m_hashUserExecutable;
+	// open62541 session this instance mirrors (UA_Session, see quaserver_anex.h)
+	void    * m_uaSession;
+	// traffic counters
+	quint64   m_requestCount[ServiceCount];
+	quint64   m_bytesReceived;
+	quint64   m_bytesSent;
+	quint32   m_monitoredItems;
+	qint64    m_latencyNSecs;
+	quint64   m_latencySamples;
+	// admission control, buckets reloaded when m_rateLimitsVersion differs from the server's
+	struct QUaTokenBucket
+	{
+		double ratePerSecond;
+		double burst;
+		double tokens;
+		qint64 lastRefill; // [ns] server rate timer
+	};
+	QUaTokenBucket m_buckets[ServiceCount];
+	quint64        m_rejectedCount[ServiceCount];
+	quint32        m_rateLimitsVersion;
+	// asynchronous method calls running for this session (see QUaBaseObject::addMethodAsync)
+	quint32        m_pendingCalls;
+
+	void addRequest(const Service &service,
+		            const qint64  &nsecs,
+		            const quint64 &bytesReceived = 0,
+		            const quint64 &bytesSent     = 0);
+	// accounts a method call with the encoded size of its arguments
+	void addCall(const qint64        &nsecs,
+		         const UA_Variant    *input,
+		         const size_t        &inputSize,
+		         const UA_Variant    *output,
+		         const size_t        &outputSize,
+		         const UA_StatusCode &status);
+	// for requests already counted (e.g. data source reads counted as Read access)
+	void addTraffic(const qint64  &nsecs,
+		            const quint64 &bytesReceived,
+		            const quint64 &bytesSent);
 };
 
 class QUaServer : public QObject
@@ -92,6 +203,7 @@ class QUaServer : public QObject
 	friend class QUaBaseObject;
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
 	friend class QUaBaseEvent;
+	friend class QUaLimitAlarms;
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 	template <typename ClassType, typename R, bool IsMutable, typename... Args> friend struct QUaMethodTraitsBase;
 #ifdef UA_ENABLE_HISTORIZING
@@ -109,6 +221,8 @@ class QUaServer : public QObject
 #endif
 	Q_PROPERTY(quint16    maxSecureChannels READ maxSecureChannels WRITE setMaxSecureChannels NOTIFY maxSecureChannelsChanged)
 	Q_PROPERTY(quint16    maxSessions       READ maxSessions       WRITE setMaxSessions       NOTIFY maxSessionsChanged      )
+	Q_PROPERTY(quint32    maxAsyncReadsInFlight READ maxAsyncReadsInFlight WRITE setMaxAsyncReadsInFlight NOTIFY maxAsyncReadsInFlightChanged)
+	Q_PROPERTY(quint32    maxPendingCallsPerSession READ maxPendingCallsPerSession WRITE setMaxPendingCallsPerSession NOTIFY maxPendingCallsPerSessionChanged)
 	Q_PROPERTY(bool       isRunning         READ isRunning         WRITE setIsRunning         NOTIFY isRunningChanged        )
 	Q_PROPERTY(QString    applicationName   READ applicationName   WRITE setApplicationName   NOTIFY applicationNameChanged  )
 	Q_PROPERTY(QString    applicationUri    READ applicationUri    WRITE setApplicationUri    NOTIFY applicationUriChanged   )
@@ -171,11 +285,27 @@ public:
 	quint16 maxSessions() const;
 	void    setMaxSessions(const quint16 &maxSessions);
 
+	// max number of asynchronous read callbacks (QUaBaseVariable::setReadCallbackAsync) running at the same time
+	quint32 maxAsyncReadsInFlight() const;
+	void    setMaxAsyncReadsInFlight(const quint32 &maxAsyncReadsInFlight);
+	// number of asynchronous read callbacks currently running
+	quint32 asyncReadsInFlight() const;
+
+	// max number of asynchronous method calls (QUaBaseObject::addMethodAsync) running per session
+	quint32 maxPendingCallsPerSession() const;
+	void    setMaxPendingCallsPerSession(const quint32 &maxPendingCallsPerSession);
+
 	// Instance Creation API
 
 	// register type in order to assign it a typeNodeId
 	template<typename T>
 	void registerType(const QString &strNodeId = "");
+	// add method to a type, all its instances share it, callback receives the instance as first argument
+	// e.g. addTypeMethod("reset", [](MyType * obj, int value) { ... })
+	// NOTE : must be called before creating instances of the type, override per instance
+	//        with QUaBaseObject::overrideMethod
+	template<typename M>
+	void addTypeMethod(const QString &strMethodName, const M &methodCallback);
 	// get all instances of a type
 	template<typename T>
 	QList<T*> typeInstances();
@@ -237,6 +367,35 @@ public:
 	template<typename T>
 	T* createEvent();
 
+	// trigger an event of a given type without creating an event instance per call,
+	// fields (browse name -> value) are written to a reusable event of that type
+	// NOTE : fields not given keep the value of the previous call, except Time which
+	//        defaults to current time and SourceName which defaults to source browse name
+	template<typename T>
+	void triggerEvent(QUaNode * sourceNode = nullptr, const QVariantMap &fields = QVariantMap());
+
+	// Event Rate Limit API
+
+	// limits the events triggered from a source node (nullptr for server), events over the rate
+	// are dropped until the suppression window ends, then a single QUaSuppressedEventsEvent 
+	// with the number of dropped events is triggered from the source, zero rate removes the limit
+	void setEventRateLimit(QUaNode * sourceNode, const double &maxEventsPerSecond, const quint32 &suppressionWindowMs = 1000);
+	// same for all events of a given type regardless of source, source limits take precedence
+	template<typename T>
+	void setEventTypeRateLimit(const double &maxEventsPerSecond, const quint32 &suppressionWindowMs = 1000);
+	void clearEventRateLimits();
+	// total number of events dropped by the rate limits
+	quint64 suppressedEventCount() const;
+
+	// Model Change API
+
+	// buffers model change events (nodes added or removed) until the matching end call,
+	// calls can be nested, when the outermost scope ends a single event is triggered,
+	// if a summary node is given all buffered changes are reported as changes of that node
+	// NOTE : prefer QUaModelChangeScope which cannot leave a scope open
+	void beginModelChanges(QUaNode * summaryNode = nullptr);
+	void endModelChanges();
+
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 
 	// Access Control API
@@ -245,20 +404,80 @@ public:
 	bool        anonymousLoginAllowed() const;
 	void        setAnonymousLoginAllowed(const bool &anonymousLoginAllowed);
 	// if user already exists, it updates password
+	// NOTE : only a salted PBKDF2-SHA256 hash of the key is kept in memory
 	void        addUser(const QString &strUserName, const QString & strKey);
+	// add user with a hash previously returned by userKey (e.g. loaded from config)
+	void        addUserHash(const QString &strUserName, const QString & strKeyHash);
 	// if user does not exist, it does nothing
 	void        removeUser(const QString &strUserName);
-	// get the key associated to the user
+	// get the hash of the key associated to the user (format pbkdf2-sha256:iterations:salt:hash)
+	// NOTE : plain keys are no longer kept, so unlike older versions this does NOT return the key,
+	//        use verifyUserKey to check a key and addUserHash to restore the user
 	QString     userKey(const QString &strUserName) const;
+	// check key against the stored hash of the user
+	bool        verifyUserKey(const QString &strUserName, const QString & strKey) const;
+	// PBKDF2 iterations used for new hashes, default QUA_KEY_HASH_ITERATIONS
+	int         keyHashIterations() const;
+	void        setKeyHashIterations(const int &iterations);
+	// successful logins are remembered for this time (in ms) so reconnecting clients skip
+	// the (slow) hash or validation callback, 0 disables, default QUA_LOGIN_CACHE_TIMEOUT
+	// NOTE : after a failed login, further logins of that user name that are not cached are
+	//        rejected without validation during an exponential backoff (QUA_LOGIN_BACKOFF_*)
+	int         loginCacheTimeout() const;
+	void        setLoginCacheTimeout(const int &timeoutMs);
 	// number of users
 	int         userCount();
 	// get all user names
 	QStringList userNames() const;
 	// check if user already exists
 	bool        userExists(const QString &strUserName) const;
-	// add a validation callback for user key, defaults checks key == password
+	// add a validation callback for user key, defaults to verifyUserKey
 	template<typename M>
 	void        setUserValidationCallback(const M &callback);
+	// user permissions are cached per session and node, call to recompute them if a reimplemented
+	// userWriteMask, userAccessLevel or userExecutable depends on state external to the server
+	// NOTE : called automatically when users, permission callbacks or nodes change
+	void        clearPermissionsCache();
+
+	// Roles API
+
+	// role based permissions are active once a role exists, up to QUA_MAX_ROLES roles
+	// users get the union of the permissions of their roles, users without roles get none
+	// the result further restricts userWriteMask, userAccessLevel and userExecutable of the nodes
+	// NOTE : browse permissions can be queried with userPermissions but are not enforced by the stack
+	bool        addRole(const QString &strRole);
+	// removes the role from all users and nodes
+	void        removeRole(const QString &strRole);
+	QStringList roleNames() const;
+	bool        roleExists(const QString &strRole) const;
+	// empty user name refers to anonymous sessions
+	void        setUserRoles(const QString &strUserName, const QStringList &roles);
+	QStringList userRoles(const QString &strUserName) const;
+	// grant or deny permissions to a role over the subtree of the given node
+	// denials override grants inherited from ancestors, the latest call wins for a given node
+	void        grantPermissions(const QString &strRole, QUaNode *node, const QUaPermissions &permissions);
+	void        denyPermissions (const QString &strRole, QUaNode *node, const QUaPermissions &permissions);
+	// removes the grants and denials of a role on the given node (descendants not affected)
+	void        clearPermissions(const QString &strRole, QUaNode *node);
+	// effective role permissions of a user on a node, all permissions if no roles exist
+	QUaPermissions userPermissions(const QString &strUserName, QUaNode *node);
+
+	// Rate Limit API
+
+	// limits the requests each session can issue per service, requests over budget are
+	// refused with BadTooManyOperations
+	// burst is the number of requests allowed at once, defaults to one second worth of requests
+	// NOTE : Read cannot be limited (asserts and is ignored), open62541 v1.0 has no hook for Read
+	//        requests that is not also used for subscription sampling and attribute reads
+	// NOTE : Write limits only refuse writes to data source variables (setDataSource,
+	//        setDataSourceMemory), other variables are notified after the value is written
+	void         setRequestRateLimit(const QUaSession::Service &service, const double &ratePerSecond, const double &burst = 0);
+	QUaRateLimit requestRateLimit   (const QUaSession::Service &service) const;
+	// overrides the default limits for the sessions of a user, empty user name refers to anonymous sessions
+	// NOTE : limits apply to each session of the user separately, not to all its sessions combined
+	void         setUserRequestRateLimit  (const QString &strUserName, const QUaSession::Service &service, const double &ratePerSecond, const double &burst = 0);
+	QUaRateLimit userRequestRateLimit     (const QString &strUserName, const QUaSession::Service &service) const;
+	void         clearUserRequestRateLimits(const QString &strUserName);
 
 	// Sessions API
 
@@ -268,8 +487,42 @@ public:
     // Historizing API
     template<typename T>
     void setHistorizer(T& historizer);
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	// record triggered events, only if the historizer implements the optional events API
+	// fields are the browse names of the event fields to record, empty records all of them
+	bool        eventHistorizing() const;
+	void        setEventHistorizing(const bool &eventHistorizing, const QStringList &fields = QStringList());
+	QStringList eventHistoryFields() const;
+	// recorded events within the time range matching the filter, the historizer is 
+	// expected to resolve the filter with its indexes, zero numEventsToRead means no limit
+	// NOTE : server side only, clients cannot read event history. open62541 v1.0 has no
+	//        HistoryRead with ReadEventDetails, so it is not served through the Historizing API
+	QVector<QUaHistoryEventPoint> readHistoryEvents(
+		const QUaDateTime           &timeStart,
+		const QUaDateTime           &timeEnd,
+		const QUaHistoryEventFilter &filter = QUaHistoryEventFilter(),
+		const quint64               &numEventsToRead = 0
+	);
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 #endif // UA_ENABLE_HISTORIZING
 
+	// Value Update Queue API
+
+	// thread-safe, can be called from any thread, the update is applied by the server thread in batches
+	// returns false if the queue is full (backpressure), the update is then dropped and counted in the stats
+	bool    enqueueValue(QUaBaseVariable *variable, const QVariant &value, const QUaDateTime &sourceTimestamp = QUaDateTime());
+	// max number of updates waiting, NOTE : only change before server is started and while no producers are running
+	quint32 valueQueueCapacity() const;
+	void    setValueQueueCapacity(const quint32 &capacity);
+	// max number of updates applied per server iteration
+	quint32 valueQueueBatchSize() const;
+	void    setValueQueueBatchSize(const quint32 &batchSize);
+	// approximate number of updates waiting
+	quint32 valueQueueSize() const;
+	// counters for enqueued, dropped and drained updates
+	QUaValueQueueStats valueQueueStats() const;
+	void               resetValueQueueStats();
+
 signals:
 	void isRunningChanged            (const bool       &running           );
 	void portChanged                 (const quint16    &port              );
@@ -279,6 +532,8 @@ signals:
 #endif							     									  
 	void maxSecureChannelsChanged    (const quint16 &maxSecureChannels    );
 	void maxSessionsChanged          (const quint16 &maxSessions          );
+	void maxAsyncReadsInFlightChanged(const quint32 &maxAsyncReadsInFlight);
+	void maxPendingCallsPerSessionChanged(const quint32 &maxPendingCallsPerSession);
 	void applicationNameChanged      (const QString &strApplicationName   );
 	void applicationUriChanged       (const QString &strApplicationUri    );
 	void productNameChanged          (const QString &strProductName       );
@@ -306,8 +561,26 @@ private:
 	quint16                 m_port;
 	quint16                 m_maxSecureChannels;
 	quint16                 m_maxSessions;
+	quint32                 m_maxAsyncReadsInFlight;
+	quint32                 m_asyncReadsInFlight;
+	quint32                 m_maxPendingCallsPerSession;
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	// running asynchronous method calls by call handle
+	QHash<quint32, QUaPendingCall> m_hashPendingCalls;
+	quint32                 m_lastCallHandle;
+	// single shot, fires at the nearest call deadline
+	QTimer                  m_callTimer;
+	// returns the call handle, completion triggers a QUaMethodCompletedEvent
+	quint32 addPendingCall(const QUaPendingCall &call);
+	void    completeCall(const quint32 &handle, const bool &timedOut);
+	void    cancelPendingCalls(QUaSession * session);
+	void    startCallTimer();
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 	UA_Boolean              m_running;
 	QTimer                  m_iterWaitTimer;
+	QUaValueQueue         * m_valueQueue;
+	quint32                 m_valueQueueBatchSize;
+	void drainValueQueue();
 	QByteArray              m_byteCertificate;
 	QByteArray              m_byteCertificateInternal; // NOTE : needs to exists as long as server instance
 	bool                    m_anonymousLoginAllowed;
@@ -337,21 +610,115 @@ private:
 	QHash<QUaReferenceType, UA_NodeId    > m_hashHierRefTypes;
 	QHash<UA_NodeId       , QUaSignaler* > m_hashSignalers;
 	QUaValidationCallback m_validationCallback;
+	int                   m_keyHashIterations;
+	// positive login cache, user name to hmac of password and expiry time
+	struct QUaLoginCacheEntry
+	{
+		QByteArray digest;
+		qint64     expiry;
+	};
+	QHash<QString, QUaLoginCacheEntry> m_hashLoginCache;
+	int                                m_loginCacheTimeout;
+	QByteArray                         m_loginCacheSecret;
+	// failed logins per user name, logins are rejected without validation until blockedUntil
+	struct QUaLoginBackoff
+	{
+		quint32 failures;
+		qint64  blockedUntil;
+	};
+	QHash<QString, QUaLoginBackoff>    m_hashLoginBackoff;
+	QByteArray loginDigest(const QString &strUserName, const QString &strPassword) const;
+	bool       validateLogin(const QString &strUserName, const QString &strPassword);
+	void       addLoginFailure(const QString &strUserName, const qint64 &now);
+	static QByteArray randomBytes(const int &size);
+	static QString hashKey(const QString &strKey, const int &iterations);
+	static bool    verifyKey(const QString &strKeyHash, const QString &strKey);
+	quint32               m_permissionsVersion;
+	// returns nullptr if session unknown or its user no longer exists
+	// NOTE : sessionContext is the QUaSession set on activation, if any
+	QUaSession * getValidSession(const UA_NodeId &sessionId, void *sessionContext = nullptr);
+	// returns nullptr for internal (admin) sessions
+	QUaSession * sessionById(const UA_NodeId *sessionId) const;
+	// role based access, role index is its bit in the masks, empty if slot free
+	QVector<QString>        m_roles;
+	QHash<QString, quint64> m_hashUserRoles;
+	QSet<QUaNode*>          m_roleRuleNodes;
+	quint32                 m_rolesVersion;
+	int  roleIndex(const QString &strRole) const;
+	// sets grants and denies of role for the given permissions of node
+	void setRoleRules(const QString &strRole, QUaNode *node, const QUaPermissions &permissions, const QUaPermissions &grants, const QUaPermissions &denies);
+	void rolesChanged();
+	// request rate limits, per service and optionally per user
+	QUaRateLimit                          m_rateLimits[QUaSession::ServiceCount];
+	QHash<QString, QVector<QUaRateLimit>> m_hashUserRateLimits;
+	quint32                               m_rateLimitsVersion;
+	QElapsedTimer                         m_rateTimer;
+	static QUaRateLimit validRateLimit(const double &ratePerSecond, const double &burst);
+	void rateLimitsChanged();
+	// consumes a token of the session bucket, false if over budget
+	bool admitRequest(QUaSession *session, const QUaSession::Service &service);
 
 	// change event instance to notify client when nodes added or removed
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
 	QUaGeneralModelChangeEvent * m_changeEvent;
-	QUaChangesList m_listChanges; // buffer
+	// buffer, keyed by (affected node id, verb), each entry merges the changes of all children
+	typedef QPair<QString, uchar> QUaChangeKey;
+	struct QUaChangeEntry
+	{
+		QUaChangeStructureDataType change;
+		// children added since last trigger still alive, entry cancels out when it drops to zero
+		quint32 addedCount;
+		// set if entry has a change that cannot be cancelled
+		bool    keep;
+		// set when cancelled, skipped on trigger so indexes stay valid
+		bool    cancelled;
+	};
+	// entries in insertion order, the hash holds the index of each live entry
+	QList<QUaChangeEntry>               m_listChanges;
+	QHash<QUaChangeKey, int>            m_hashChanges;
+	// node id -> key of the parent entry, for nodes added since last trigger
+	QHash<QString, QUaChangeKey>        m_hashAddedNodes;
+	QList<QUaChangeStructureDataType>   m_listSummaryChanges;
+	quint32                             m_modelChangeScopes;
 	std::function<void(void)> m_triggerChanges;
-	void addChange(const QUaChangeStructureDataType& change);
+	void addChange(QUaNode * parentNode, const QString &strNodeId, const QUaChangeVerb &verb);
+	// drops buffered changes affecting a deleted node, and the additions of its children
+	void cancelChanges(const QString &strNodeId);
+	void cancelChange(const QUaChangeKey &key);
+	void clearChanges();
+	void triggerChanges();
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 
 #ifdef UA_ENABLE_HISTORIZING
     UA_HistoryDatabase m_historDatabase;
     QUaHistoryBackend  m_historBackend;
     UA_HistoryDataGathering getGathering() const;
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+	bool          m_eventHistorizing;
+	QStringList   m_eventHistoryFields;
+	QSet<QString> m_setEventHistoryFields;
+	void historizeEvent(QUaBaseEvent * event, const UA_NodeId &sourceNodeId);
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 #endif // UA_ENABLE_HISTORIZING
 
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+	// monitored items of variables with exception based reporting
+	QMultiHash<QUaBaseVariable*, UA_MonitoredItem*> m_hashMonitoredItems;
+	void triggerMonitoredItems    (QUaBaseVariable *variable);
+	void setMonitoredItemsSampling(QUaBaseVariable *variable, const bool &enabled);
+	static void monitoredItemRegister(UA_Server        *server,
+		                              const UA_NodeId  *sessionId,
+		                              void             *sessionContext,
+		                              const UA_NodeId  *nodeId,
+		                              void             *nodeContext,
+		                              UA_UInt32         attibuteId,
+		                              UA_Boolean        removed);
+#endif // UA_ENABLE_SUBSCRIPTIONS
+
+	// set valueRank and arrayDimensions of a variable at once, bypassing the consistency checks
+	// that prevent going from one multidimensional shape to another one attribute at a time
+	UA_StatusCode writeValueShape(const UA_NodeId &nodeId, const qint32 &valueRank, const QVector<quint32> &arrayDimensions);
+
 	// reset open62541 config
 	void resetConfig();
 
@@ -382,6 +749,18 @@ private:
 	void registerMetaEnums(const QMetaObject &parentMetaObject);
 	void addMetaProperties(const QMetaObject &parentMetaObject);
 	void addMetaMethods   (const QMetaObject &parentMetaObject);
+	// adds method node to type and keeps it by name
+	UA_NodeId addTypeMethodNodeInternal(const QMetaObject &metaObject,
+		                                QByteArray        &byteMethodName,
+		                                const size_t      &nArgs,
+		                                UA_Argument       *inputArguments,
+		                                UA_Argument       *outputArgument);
+	// null if neither type nor its base types have the method
+	UA_NodeId typeMethodNodeId(const QMetaObject &metaObject, const QString &strMethodName) const;
+	// true if arguments and result have the same data types and value ranks as the type method
+	// NOTE : takes ownership of the arguments
+	bool matchesTypeMethod(const UA_NodeId &methNodeId, QVector<UA_Argument> inputArguments, UA_Argument outputArgument) const;
+	static QString methodSignature(const size_t &nArgs, const UA_Argument * inputArguments, const UA_Argument * outputArgument);
 
 	UA_NodeId createInstance(const QMetaObject &metaObject, QUaNode * parentNode, const QString &strNodeId = "");
 
@@ -390,6 +769,49 @@ private:
 	// create instance of a given event type
 	UA_NodeId createEvent(const QMetaObject &metaObject, const UA_NodeId &nodeIdOriginator, const QStringList * defaultProperties);
 
+	// reusable event used by triggerEvent, fields resolved once when created
+	struct QUaEventTemplate
+	{
+		UA_NodeId      nodeId;
+		QUaBaseEvent * event;
+		QHash<QString, QUaBaseVariable*> fields;
+		QHash<QString, QMetaType::Type>  types;
+		// values on creation, restored when a later trigger does not supply the field
+		QHash<QString, UA_Variant>       defaults;
+		QSet<QString>                    written;
+	};
+	QHash<QString, QUaEventTemplate> m_hashEventTemplates;
+
+	void triggerEvent(const QMetaObject &metaObject, QUaNode * sourceNode, const QVariantMap &fields, const QStringList * defaultProperties);
+
+	// event rate limit of a source or type, with its bucket and suppression window state
+	struct QUaEventThrottle
+	{
+		QUaRateLimit      limit;
+		quint32           suppressionWindowMs;
+		double            tokens;
+		qint64            lastRefill;
+		bool              suppressing;
+		quint64           window;
+		quint32           suppressedCount;
+		quint16           maxSeverity;
+		QString           strSuppressedType;
+		QPointer<QUaNode> lastSource;
+	};
+	QHash<QUaNode*, QUaEventThrottle> m_hashSourceEventThrottles;
+	QHash<QString , QUaEventThrottle> m_hashTypeEventThrottles;
+	quint64 m_suppressedEventCount;
+	// stamps each suppression window, a timer only ends the window it was started for
+	quint64 m_suppressionWindowCount;
+
+	void setEventTypeRateLimit(const QString &strClassName, const double &maxEventsPerSecond, const quint32 &suppressionWindowMs);
+	static QUaEventThrottle newEventThrottle(const double &maxEventsPerSecond, const quint32 &suppressionWindowMs, const qint64 &now);
+	bool eventRateLimited() const;
+	// consumes a token of the source or type bucket, false if the event must be dropped
+	bool admitEvent(QUaNode * sourceNode, const QMetaObject &metaObject, const quint16 &severity);
+	// triggers the summary event if any event was dropped during the window
+	void endEventSuppression(QUaEventThrottle &throttle);
+
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 
 	void bindCppInstanceWithUaNode(QUaNode * nodeInstance, UA_NodeId &nodeId);
@@ -398,7 +820,10 @@ private:
 	QMetaObject getRegisteredMetaObject(const QString& strClassName) const;
 
 	QHash< UA_NodeId, std::function<UA_StatusCode(const UA_NodeId *nodeId, void ** nodeContext)>> m_hashConstructors;
+	// methods shared by all instances of a type, keyed by method node (instance is the objectContext)
 	QHash< UA_NodeId, std::function<UA_StatusCode(void *, const UA_Variant*, UA_Variant*)>      > m_hashMethods;
+	QHash< QString  , QHash<QString, UA_NodeId>                                                 > m_hashTypeMethods;
+	QHash< UA_NodeId, QString                                                                   > m_hashTypeMethodSignatures;
 
 	static UA_NodeId getReferenceTypeId(const QMetaObject &parentMetaObject, const QMetaObject &childMetaObject);
 
@@ -434,6 +859,8 @@ private:
 		                                const UA_Variant *input,
 		                                size_t            outputSize,
 		                                UA_Variant       *output);
+	// dispatch to instance override or type method
+	UA_StatusCode callMethod(const UA_NodeId *methodId, void *objectContext, const UA_Variant *input, UA_Variant *output);
 
 	static bool isNodeBound(const UA_NodeId &nodeId, UA_Server *server);
 
@@ -456,8 +883,14 @@ private:
 		                                 const UA_ExtensionObject     *userIdentityToken,
 		                                 void                        **sessionContext);
 
-	static void newSession(QUaServer* server, 
-		                   const UA_NodeId* sessionId);
+	// NOTE : open62541 passes &UA_Session::sessionHandle as sessionContext to activateSession
+	static void * uaSessionFromContext(void           **sessionContext,
+		                               const UA_NodeId *sessionId);
+
+	static void newSession(QUaServer  * server, 
+		                   QUaSession * session);
+	// reads the peer address of the channel the session is attached to
+	static void updateSessionAddress(QUaSession * session);
 
 	static void closeSession(UA_Server        *server, 
 		                     UA_AccessControl *ac, 
@@ -503,6 +936,33 @@ private:
 	const QStringList * m_newEventDefaultProperties;
 };
 
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+// Buffers model change events while alive, e.g. during bulk node creation or deletion
+// (see QUaServer::beginModelChanges)
+class QUaModelChangeScope
+{
+public:
+	explicit QUaModelChangeScope(QUaServer * server, QUaNode * summaryNode = nullptr);
+	~QUaModelChangeScope();
+
+private:
+	Q_DISABLE_COPY(QUaModelChangeScope)
+	QUaServer * m_server;
+};
+
+inline QUaModelChangeScope::QUaModelChangeScope(QUaServer * server, QUaNode * summaryNode/* = nullptr*/)
+	: m_server(server)
+{
+	Q_CHECK_PTR(m_server);
+	m_server->beginModelChanges(summaryNode);
+}
+
+inline QUaModelChangeScope::~QUaModelChangeScope()
+{
+	m_server->endModelChanges();
+}
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
 template<typename T>
 inline void QUaServer::registerType(const QString &strNodeId/* = ""*/)
 {
@@ -632,6 +1092,22 @@ inline T * QUaServer::createEvent()
 	return newEvent;
 }
 
+template<typename T>
+inline void QUaServer::triggerEvent(QUaNode * sourceNode/* = nullptr*/, const QVariantMap &fields/* = QVariantMap()*/)
+{
+	const QStringList * defaultProperties = getDefaultPropertiesRef<T>();
+	Q_ASSERT(defaultProperties);
+	// call internal method
+	this->triggerEvent(T::staticMetaObject, sourceNode, fields, defaultProperties);
+}
+
+template<typename T>
+inline void QUaServer::setEventTypeRateLimit(const double &maxEventsPerSecond, const quint32 &suppressionWindowMs/* = 1000*/)
+{
+	// call internal method
+	this->setEventTypeRateLimit(QString(T::staticMetaObject.className()), maxEventsPerSecond, suppressionWindowMs);
+}
+
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
 
 template<typename T>
@@ -652,6 +1128,9 @@ inline void QUaServer::setUserValidationCallback(const M & callback)
 	m_validationCallback = [callback](const QString &strUserName, const QString &strPassword) {
 		return callback(strUserName, strPassword);
 	};
+	// logins accepted by the previous callback must be validated again
+	m_hashLoginCache.clear();
+	m_hashLoginBackoff.clear();
 }
 
 #ifdef UA_ENABLE_HISTORIZING
@@ -1097,6 +1576,26 @@ inline void QUaBaseVariable::setDataTypeEnum()
 	this->setDataTypeEnum(QMetaEnum::fromType<T>());
 }
 
+template<typename T>
+inline void QUaBaseVariable::setDataSourceMemory(T * data, const quint32 &arrayLength/* = 0*/)
+{
+	static_assert(std::is_arithmetic<T>::value, "QUaBaseVariable::setDataSourceMemory only supports numeric types.");
+	this->setDataSourceMemoryInternal(
+		static_cast<void*>(data),
+		QUaTypesConverter::qtTypeFromCpp<T>(),
+		arrayLength
+	);
+}
+
+template<typename T>
+inline void QUaBaseVariable::setValueArray(const T * data, const QVector<quint32> &arrayDimensions)
+{
+	static_assert(std::is_arithmetic<T>::value, "QUaBaseVariable::setValueArray only supports numeric types.");
+	UA_Variant uaValue = QUaTypesConverter::uaVariantFromBuffer(data, arrayDimensions);
+	this->setValueArrayInternal(uaValue, static_cast<QMetaType::Type>(qMetaTypeId<T>()));
+	UA_Variant_clear(&uaValue);
+}
+
 // NOTE : had to remove template template parameters because is c++17
 template <typename T>
 struct container_traits : std::false_type {};
@@ -1113,9 +1612,31 @@ struct container_traits<QVector<T>> : std::true_type
 	using inner_type = T;
 };
 
+template <typename T>
+struct future_traits : std::false_type
+{};
+
+template <typename T>
+struct future_traits<QFuture<T>> : std::true_type
+{
+	using inner_type = T;
+};
+
+// true if any argument is a view into the request buffers
+template <typename... Args>
+struct any_view_traits : std::false_type
+{};
+
+template <typename T, typename... Args>
+struct any_view_traits<T, Args...> : std::integral_constant<bool,
+	view_traits<typename std::decay<T>::type>::value || any_view_traits<Args...>::value>
+{};
+
 template <typename ClassType, typename R, bool IsMutable, typename... Args>
 struct QUaMethodTraitsBase
 {
+    using ret_type = R;
+
     inline static bool getIsMutable()
     {
         return IsMutable;
@@ -1126,6 +1647,11 @@ struct QUaMethodTraitsBase
         return sizeof...(Args);
     }
 
+    static constexpr bool hasViewArgs()
+    {
+        return any_view_traits<Args...>::value;
+    }
+
     template<typename T>
     inline static QString getTypeName()
     {
@@ -1146,9 +1672,25 @@ struct QUaMethodTraitsBase
 	template<typename T>
 	inline static UA_Argument getTypeUaArgument(QUaServer * uaServer, const int &iArg = 0)
 	{
+        return getTypeUaArgumentInternalView<T>(view_traits<typename std::decay<T>::type>(), uaServer, iArg);
+	}
+
+	template<typename T>
+	inline static UA_Argument getTypeUaArgumentInternalView(std::false_type, QUaServer * uaServer, const int &iArg = 0)
+	{
         return getTypeUaArgumentInternalArray<T>(container_traits<T>(), uaServer, iArg);
 	}
 
+	template<typename T>
+	inline static UA_Argument getTypeUaArgumentInternalView(std::true_type, QUaServer * uaServer, const int &iArg = 0)
+	{
+        Q_UNUSED(uaServer);
+        using V = typename std::decay<T>::type;
+        UA_Argument arg = getTypeUaArgumentInternal<T>(view_traits<V>::uaTypeNodeId(), iArg);
+        arg.valueRank = view_traits<V>::valueRank;
+        return arg;
+	}
+
 	template<typename T>
 	inline static UA_Argument getTypeUaArgumentInternalArray(std::false_type, QUaServer * uaServer, const int &iArg = 0)
 	{
@@ -1214,9 +1756,28 @@ struct QUaMethodTraitsBase
 
 	inline static UA_Argument getRetUaArgument()
 	{
-        return getRetUaArgumentArray<R>(container_traits<R>());
+        return getRetUaArgumentBuffer<R>(buffer_traits<R>());
 	}
 
+	template<typename T>
+    inline static UA_Argument getRetUaArgumentBuffer(std::false_type)
+    {
+        return getRetUaArgumentArray<T>(container_traits<T>());
+    }
+
+	template<typename T>
+    inline static UA_Argument getRetUaArgumentBuffer(std::true_type)
+    {
+        UA_Argument outputArgument;
+        UA_Argument_init(&outputArgument);
+        outputArgument.description = UA_LOCALIZEDTEXT((char *)"",
+                                                      (char *)"Result Value");
+        outputArgument.name        = QUaTypesConverter::uaStringFromQString((char *)"Result");
+        outputArgument.dataType    = buffer_traits<T>::uaTypeNodeId();
+        outputArgument.valueRank   = buffer_traits<T>::valueRank;
+        return outputArgument;
+    }
+
 	template<typename T>
     inline static UA_Argument getRetUaArgumentArray(std::false_type)
     {
@@ -1250,10 +1811,42 @@ struct QUaMethodTraitsBase
 
     template<typename T>
     inline static T convertArgType(const UA_Variant * input, const int &iArg)
+    {
+        return convertArgTypeView<T>(view_traits<typename std::decay<T>::type>(), input, iArg);
+    }
+
+    template<typename T>
+    inline static T convertArgTypeView(std::false_type, const UA_Variant * input, const int &iArg)
     {
         return convertArgTypeArray<T>(container_traits<T>(), input, iArg);
     }
 
+	// no copy, view onto request data
+    template<typename T>
+    inline static T convertArgTypeView(std::true_type, const UA_Variant * input, const int &iArg)
+    {
+        return std::decay<T>::type::fromUaVariant(input[iArg]);
+    }
+
+    template<typename T>
+    inline static UA_Variant convertRetType(T result)
+    {
+        return convertRetTypeBuffer<T>(buffer_traits<T>(), result);
+    }
+
+    template<typename T>
+    inline static UA_Variant convertRetTypeBuffer(std::false_type, T &result)
+    {
+        return QUaTypesConverter::uaVariantFromQVariant(QVariant::fromValue(result));
+    }
+
+	// no copy, response adopts buffer
+    template<typename T>
+    inline static UA_Variant convertRetTypeBuffer(std::true_type, T &result)
+    {
+        return result.release();
+    }
+
 	template<typename T>
 	inline static T convertArgTypeArray(std::false_type, const UA_Variant * input, const int &iArg)
 	{
@@ -1274,22 +1867,72 @@ struct QUaMethodTraitsBase
 		return retArr;
 	}
 
+	// type methods, instance passed as first argument
+    template<typename M, typename O>
+    inline static UA_Variant execCallbackObject(std::false_type, const M &methodCallback, O * object, const UA_Variant * input)
+    {
+        // NOTE : arguments inverted when calling "methodCallback"? only x++ and x-- work (i.e. not --x)?
+        int iArg = (int)getNumArgs() - 1;
+        // call method and set result
+        return convertRetType<R>(methodCallback(object, convertArgType<Args>(input, iArg--)...));
+    }
+
+    template<typename M, typename O>
+    inline static UA_Variant execCallbackObject(std::true_type, const M &methodCallback, O * object, const UA_Variant * input)
+    {
+        // NOTE : arguments inverted when calling "methodCallback"? only x++ and x-- work (i.e. not --x)?
+        int iArg = (int)getNumArgs() - 1;
+        // call method
+        methodCallback(object, convertArgType<Args>(input, iArg--)...);
+        // no result
+        return UA_Variant();
+    }
+
+    template<typename M>
+    inline static R execCallbackFuture(const M &methodCallback, const UA_Variant * input)
+    {
+        // NOTE : arguments inverted when calling "methodCallback"? only x++ and x-- work (i.e. not --x)?
+        int iArg = (int)getNumArgs() - 1;
+        // call method, returns the future as is
+        return methodCallback(convertArgType<Args>(input, iArg--)...);
+    }
+
     template<typename M>
     inline static UA_Variant execCallback(const M &methodCallback, const UA_Variant * input)
     {
         // call method
         // NOTE : arguments inverted when calling "methodCallback"? only x++ and x-- work (i.e. not --x)?
         int iArg = (int)getNumArgs() - 1;
-        // call method
-        QVariant varResult = QVariant::fromValue(methodCallback(convertArgType<Args>(input, iArg--)...));
-        // set result
-        UA_Variant retVar = QUaTypesConverter::uaVariantFromQVariant(varResult);
+        // call method and set result
+        UA_Variant retVar = convertRetType<R>(methodCallback(convertArgType<Args>(input, iArg--)...));
 
         // TODO : cleanup? UA_Variant_deleteMembers(&retVar);
 
         return retVar;
     }
 };
+// type methods, first argument is the instance
+template<typename T>
+struct QUaTypeMethodTraits : QUaTypeMethodTraits<decltype(&T::operator())>
+{};
+// specialization - const
+template <typename ClassType, typename R, typename O, typename... Args>
+struct QUaTypeMethodTraits< R(ClassType::*)(O*, Args...) const > : QUaMethodTraitsBase<ClassType, R, false, Args...>
+{
+	using object_type = O;
+};
+// specialization - mutable
+template <typename ClassType, typename R, typename O, typename... Args>
+struct QUaTypeMethodTraits< R(ClassType::*)(O*, Args...) > : QUaMethodTraitsBase<ClassType, R, true, Args...>
+{
+	using object_type = O;
+};
+// specialization - function pointer
+template <typename R, typename O, typename... Args>
+struct QUaTypeMethodTraits< R(*)(O*, Args...) > : QUaMethodTraitsBase<void, R, true, Args...>
+{
+	using object_type = O;
+};
 // general case
 template<typename T>
 struct QOpcUaMethodTraits : QOpcUaMethodTraits<decltype(&T::operator())>
@@ -1400,4 +2043,135 @@ inline void QUaBaseObject::addMethod(const QString & strMethodName, const M & me
     };
 }
 
+template<typename M>
+inline void QUaServer::addTypeMethod(const QString & strMethodName, const M & methodCallback)
+{
+    using O = typename QUaTypeMethodTraits<M>::object_type;
+    static_assert(std::is_base_of<QUaBaseObject, O>::value, "Type methods can only be added to QUaBaseObject derived types.");
+    // register type if not already
+    this->registerType(O::staticMetaObject);
+    // create input arguments
+    UA_Argument * p_inputArguments = nullptr;
+    QVector<UA_Argument> listInputArguments;
+    if (QUaTypeMethodTraits<M>::getNumArgs() > 0)
+    {
+        listInputArguments = QUaTypeMethodTraits<M>::getArgsUaArguments(this);
+        p_inputArguments = listInputArguments.data();
+    }
+    // create output arguments
+    UA_Argument * p_outputArgument = nullptr;
+    UA_Argument outputArgument;
+    if (!QUaTypeMethodTraits<M>::isRetUaArgumentVoid())
+    {
+        outputArgument = QUaTypeMethodTraits<M>::getRetUaArgument();
+        p_outputArgument = &outputArgument;
+    }
+    // add method node to type
+    QByteArray byteMethodName = strMethodName.toUtf8();
+    UA_NodeId methNodeId = this->addTypeMethodNodeInternal(
+        O::staticMetaObject,
+        byteMethodName,
+        QUaTypeMethodTraits<M>::getNumArgs(),
+        p_inputArguments,
+        p_outputArgument
+    );
+    // store method with node id hash as key
+    Q_ASSERT_X(!m_hashMethods.contains(methNodeId), "QUaServer::addTypeMethod", "Method already exists, callback will be overwritten.");
+    m_hashMethods[methNodeId] = [methodCallback](void * objectContext, const UA_Variant * input, UA_Variant * output) {
+        // get object instance that owns method
+        O * object = qobject_cast<O*>(static_cast<QObject*>(objectContext));
+        Q_ASSERT_X(object, "QUaServer::addTypeMethod", "Cannot call method on invalid C++ object.");
+        if (!object)
+        {
+            return (UA_StatusCode)UA_STATUSCODE_BADUNEXPECTEDERROR;
+        }
+        UA_Variant result = QUaTypeMethodTraits<M>::execCallbackObject(
+            std::is_void<typename QUaTypeMethodTraits<M>::ret_type>(), methodCallback, object, input);
+        if (!QUaTypeMethodTraits<M>::isRetUaArgumentVoid())
+        {
+            *output = result;
+        }
+        // return success status
+        return (UA_StatusCode)UA_STATUSCODE_GOOD;
+    };
+}
+
+template<typename M>
+inline void QUaBaseObject::overrideMethod(const QString & strMethodName, const M & methodCallback)
+{
+    // find shared method node of the type
+    UA_NodeId methNodeId = m_qUaServer->typeMethodNodeId(*this->metaObject(), strMethodName);
+    Q_ASSERT_X(!UA_NodeId_isNull(&methNodeId), "QUaBaseObject::overrideMethod", "Type has no method with the given name.");
+    if (UA_NodeId_isNull(&methNodeId))
+    {
+        return;
+    }
+    // clients see the arguments of the type method, the override must convert the same ones
+    Q_ASSERT_X(m_qUaServer->matchesTypeMethod(methNodeId,
+        QOpcUaMethodTraits<M>::getArgsUaArguments(m_qUaServer),
+        QOpcUaMethodTraits<M>::getRetUaArgument()),
+        "QUaBaseObject::overrideMethod", "Override arguments or return type differ from the type method.");
+    // dispatched before the type callback (see QUaServer::methodCallback)
+    m_hashMethods[methNodeId] = [methodCallback](const UA_Variant * input, UA_Variant * output) {
+        // call method
+        if (QOpcUaMethodTraits<M>::isRetUaArgumentVoid())
+        {
+            QOpcUaMethodTraits<M>::execCallback(methodCallback, input);
+        }
+        else
+        {
+            *output = QOpcUaMethodTraits<M>::execCallback(methodCallback, input);
+        }
+        // return success status
+        return UA_STATUSCODE_GOOD;
+    };
+}
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+template<typename M>
+inline void QUaBaseObject::addMethodAsync(const QString & strMethodName, const M & methodCallback, const quint32 & timeoutMs, const QString & strNodeId)
+{
+    using F = typename QOpcUaMethodTraits<M>::ret_type;
+    static_assert(future_traits<F>::value, "Asynchronous method callback must return a QFuture.");
+    // views point into the request, which is freed when the Call returns
+    static_assert(!QOpcUaMethodTraits<M>::hasViewArgs(), "Asynchronous method callback cannot take QUaArrayView or QUaByteArrayView arguments, use owning containers.");
+    using T = typename future_traits<F>::inner_type;
+    // create input arguments
+    UA_Argument * p_inputArguments = nullptr;
+    QVector<UA_Argument> listInputArguments;
+    if (QOpcUaMethodTraits<M>::getNumArgs() > 0)
+    {
+        listInputArguments = QOpcUaMethodTraits<M>::getArgsUaArguments(m_qUaServer);
+        p_inputArguments = listInputArguments.data();
+    }
+    // output argument is the call handle, the result is reported by QUaMethodCompletedEvent
+    UA_Argument outputArgument;
+    UA_Argument_init(&outputArgument);
+    outputArgument.description = UA_LOCALIZEDTEXT((char *)"",
+                                                  (char *)"Handle of the QUaMethodCompletedEvent reporting the result");
+    outputArgument.name        = UA_STRING((char *)"CallHandle");
+    outputArgument.dataType    = UA_TYPES[UA_TYPES_UINT32].typeId;
+    outputArgument.valueRank   = UA_VALUERANK_SCALAR;
+    // add method node
+    QByteArray byteMethodName = strMethodName.toUtf8();
+    UA_NodeId methNodeId = this->addMethodNodeInternal(
+        byteMethodName,
+        strNodeId,
+        QOpcUaMethodTraits<M>::getNumArgs(),
+        p_inputArguments,
+        &outputArgument
+    );
+    // store method with node id hash as key
+    Q_ASSERT_X(!m_hashAsyncMethods.contains(methNodeId), "QUaBaseObject::addMethodAsync", "Method already exists, callback will be overwritten.");
+    m_hashAsyncMethods[methNodeId] = [methodCallback, timeoutMs, strMethodName](const UA_Variant * input) {
+        QUaPendingCall call = QUaPendingCall::fromFuture<T>(
+            QOpcUaMethodTraits<M>::execCallbackFuture(methodCallback, input), 
+            timeoutMs
+        );
+        call.strMethodName = strMethodName;
+        return call;
+    };
+}
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
 #endif // QUASERVER_H
@@ -22,12 +22,18 @@ SOURCES += \
     $$PWD/quabasedatavariable.cpp \
     $$PWD/quabaseobject.cpp \
     $$PWD/quafolderobject.cpp \
-    $$PWD/quacustomdatatypes.cpp
+    $$PWD/quacustomdatatypes.cpp \
+    $$PWD/quavaluequeue.cpp \
+    $$PWD/quaarrayview.cpp
 
 ua_events {
     SOURCES += \
     $$PWD/quabaseevent.cpp \
-    $$PWD/quageneralmodelchangeevent.cpp
+    $$PWD/quageneralmodelchangeevent.cpp \
+    $$PWD/quasuppressedeventsevent.cpp \
+    $$PWD/quamethodcompletedevent.cpp \
+    $$PWD/quaalarmconditionevent.cpp \
+    $$PWD/qualimitalarms.cpp
 }
 
 ua_historizing {
@@ -46,12 +52,18 @@ HEADERS += \
     $$PWD/quabasedatavariable.h \
     $$PWD/quabaseobject.h \
     $$PWD/quafolderobject.h \
-    $$PWD/quacustomdatatypes.h
+    $$PWD/quacustomdatatypes.h \
+    $$PWD/quavaluequeue.h \
+    $$PWD/quaarrayview.h
 
 ua_events {
     HEADERS += \
     $$PWD/quabaseevent.h \
-    $$PWD/quageneralmodelchangeevent.h
+    $$PWD/quageneralmodelchangeevent.h \
+    $$PWD/quasuppressedeventsevent.h \
+    $$PWD/quamethodcompletedevent.h \
+    $$PWD/quaalarmconditionevent.h \
+    $$PWD/qualimitalarms.h
 }
 
 ua_historizing {
@@ -70,12 +82,18 @@ DISTFILES += \
     $$PWD/QUaBaseDataVariable \
     $$PWD/QUaBaseObject \
     $$PWD/QUaFolderObject \
-    $$PWD/QUaCustomDataTypes
+    $$PWD/QUaCustomDataTypes \
+    $$PWD/QUaValueQueue \
+    $$PWD/QUaArrayView
 
 ua_events {
     DISTFILES += \
     $$PWD/QUaBaseEvent \
-    $$PWD/QUaGeneralModelChangeEvent
+    $$PWD/QUaGeneralModelChangeEvent \
+    $$PWD/QUaSuppressedEventsEvent \
+    $$PWD/QUaMethodCompletedEvent \
+    $$PWD/QUaAlarmConditionEvent \
+    $$PWD/QUaLimitAlarms
 }
 
 ua_historizing {
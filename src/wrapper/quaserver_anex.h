@@ -379,6 +379,61 @@ UA_SessionManager_init(UA_SessionManager* sm, UA_Server* server);
 extern "C" void UA_SessionManager_deleteMembers(UA_SessionManager* sm);
 
 
+#ifdef UA_ENABLE_SUBSCRIPTIONS
+/*********************************************************************************************
+Copied from open62541, to be able to implement:
+
+QUaServer::monitoredItemRegister
+QUaServer::triggerMonitoredItems
+QUaServer::setMonitoredItemsSampling
+
+NOTE : only the leading members are copied, they are needed to get the monitored item
+       from the nodeId passed to config->monitoredItemRegisterCallback, which points
+       to UA_MonitoredItem::monitoredNodeId
+*/
+
+struct UA_Subscription;
+
+struct UA_MonitoredItem {
+    UA_DelayedCallback delayedFreePointers;
+    LIST_ENTRY(UA_MonitoredItem) listEntry;
+    UA_Subscription* subscription; /* Local MonitoredItem if the subscription is NULL */
+    UA_UInt32 monitoredItemId;
+    UA_UInt32 clientHandle;
+    UA_Boolean registered; /* Was the MonitoredItem registered in Userland with the callback? */
+
+    /* Settings */
+    UA_TimestampsToReturn timestampsToReturn;
+    UA_MonitoringMode monitoringMode;
+    UA_NodeId monitoredNodeId;
+    UA_UInt32 attributeId;
+    /* ... rest of members not needed */
+};
+
+extern "C" void
+UA_MonitoredItem_sampleCallback(UA_Server* server, UA_MonitoredItem* monitoredItem);
+
+extern "C" UA_StatusCode
+UA_MonitoredItem_registerSampleCallback(UA_Server* server, UA_MonitoredItem* mon);
+
+extern "C" void
+UA_MonitoredItem_unregisterSampleCallback(UA_Server* server, UA_MonitoredItem* mon);
+
+#endif // UA_ENABLE_SUBSCRIPTIONS
+
+/*********************************************************************************************
+Copied from open62541, to be able to implement:
+
+QUaServer::writeValueShape
+*/
+
+typedef UA_StatusCode (*UA_EditNodeCallback)(UA_Server*, UA_Session*, UA_Node* node, void*);
+
+/* Edit a node in place, the callback modifies the node stored in the nodestore directly (no copy in v1.0) */
+extern "C" UA_StatusCode
+UA_Server_editNode(UA_Server* server, UA_Session* session, const UA_NodeId* nodeId,
+                   UA_EditNodeCallback callback, void* data);
+
 /*********************************************************************************************
 Copied from open62541, to be able to implement:
 
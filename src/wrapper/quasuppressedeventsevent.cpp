@@ -0,0 +1,22 @@
+#include "quasuppressedeventsevent.h"
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
+QUaSuppressedEventsEvent::QUaSuppressedEventsEvent(QUaServer *server)
+	: QUaBaseEvent(server)
+{
+	m_suppressedCount     = this->findChild<QUaProperty*>("suppressedCount");
+	m_suppressedEventType = this->findChild<QUaProperty*>("suppressedEventType");
+}
+
+QUaProperty * QUaSuppressedEventsEvent::suppressedCount()
+{
+	return m_suppressedCount;
+}
+
+QUaProperty * QUaSuppressedEventsEvent::suppressedEventType()
+{
+	return m_suppressedEventType;
+}
+
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
@@ -0,0 +1,38 @@
+#ifndef QUASUPPRESSEDEVENTSEVENT_H
+#define QUASUPPRESSEDEVENTSEVENT_H
+
+#include <QUaBaseEvent>
+
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
+/*
+Summary event triggered by QUaServer when an event rate limit suppression window ends.
+It is triggered from the same source as the suppressed events, its Severity is the highest
+severity among the suppressed events.
+*/
+
+class QUaSuppressedEventsEvent : public QUaBaseEvent
+{
+    Q_OBJECT
+
+	// UInt32 : number of events dropped during the suppression window
+	Q_PROPERTY(QUaProperty * suppressedCount     READ suppressedCount    )
+	// String : class name of the last suppressed event
+	Q_PROPERTY(QUaProperty * suppressedEventType READ suppressedEventType)
+
+public:
+	Q_INVOKABLE explicit QUaSuppressedEventsEvent(QUaServer *server);
+
+	QUaProperty * suppressedCount();
+	QUaProperty * suppressedEventType();
+
+private:
+	// cached on construction
+	QUaProperty * m_suppressedCount;
+	QUaProperty * m_suppressedEventType;
+
+};
+
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+
+#endif // QUASUPPRESSEDEVENTSEVENT_H
@@ -1,12 +1,229 @@
 #include "quatypesconverter.h"
 #include <cstring>
+#include <atomic>
+#include <QHash>
+#include <QCache>
+
+// number of slots reserved for the custom metatypes (offset from QMetaType::User)
+#define QUA_CONVERTER_CUSTOM_TYPES 8
 
 QT_BEGIN_NAMESPACE
 
 namespace QUaTypesConverter {
 
+	// NOTE : conversions are dispatched through a table built once, indexed by qt metatype id
+	//        (custom metatypes by their offset from QMetaType::User) and by ua type index,
+	//        so converting a value is a single indirect call instead of walking a switch
+	typedef UA_Variant (*QUaFromQtFunc)(const QVariant   &var, const UA_DataType *type);
+	typedef QVariant   (*QUaToQtFunc  )(const UA_Variant &var, QMetaType::Type    type);
+
+	struct QUaFromQtConverter
+	{
+		const UA_DataType *uaType;
+		QUaFromQtFunc      scalar;
+		QUaFromQtFunc      array;
+	};
+
+	struct QUaToQtConverter
+	{
+		QMetaType::Type qtType;
+		QUaToQtFunc     scalar;
+		QUaToQtFunc     list;
+		QUaToQtFunc     vector;
+	};
+
+	struct QUaConverterTable
+	{
+		QUaFromQtConverter builtin[QMetaType::HighestInternalId + 1];
+		QUaFromQtConverter custom [QUA_CONVERTER_CUSTOM_TYPES];
+		QUaToQtConverter   ua     [UA_TYPES_COUNT];
+	};
+
+	// defined at the end of the file, after all converter specializations
+	static const QUaConverterTable & converterTable();
+
+	static inline const QUaFromQtConverter * fromQtConverter(const int &qtType)
+	{
+		const QUaConverterTable &table = converterTable();
+		if (qtType >= 0 && qtType <= QMetaType::HighestInternalId)
+		{
+			return &table.builtin[qtType];
+		}
+		const int offset = qtType - QMetaType::User;
+		if (offset >= 0 && offset < QUA_CONVERTER_CUSTOM_TYPES)
+		{
+			return &table.custom[offset];
+		}
+		return nullptr;
+	}
+
+	static inline const QUaToQtConverter * toQtConverter(const UA_DataType * uaType)
+	{
+		// only types of the namespace zero table can be dispatched by index
+		if (uaType->typeIndex >= UA_TYPES_COUNT || uaType != &UA_TYPES[uaType->typeIndex])
+		{
+			return nullptr;
+		}
+		return &converterTable().ua[uaType->typeIndex];
+	}
+
+	// owns a copy of the node id when stored in the cache, lookups use a non-owning key
+	struct QUaNodeIdKey
+	{
+		QUaNodeIdKey(const UA_NodeId &id, const bool &owned = true)
+			: owned(owned)
+		{
+			if (owned)
+			{
+				UA_NodeId_copy(&id, &nodeId);
+				return;
+			}
+			nodeId = id;
+		}
+		QUaNodeIdKey(const QUaNodeIdKey &other)
+			: owned(true)
+		{
+			UA_NodeId_copy(&other.nodeId, &nodeId);
+		}
+		QUaNodeIdKey & operator=(const QUaNodeIdKey &other)
+		{
+			if (this != &other)
+			{
+				if (owned)
+				{
+					UA_NodeId_clear(&nodeId);
+				}
+				UA_NodeId_copy(&other.nodeId, &nodeId);
+				owned = true;
+			}
+			return *this;
+		}
+		~QUaNodeIdKey()
+		{
+			if (owned)
+			{
+				UA_NodeId_clear(&nodeId);
+			}
+		}
+		bool operator==(const QUaNodeIdKey &other) const
+		{
+			return UA_NodeId_equal(&nodeId, &other.nodeId);
+		}
+		UA_NodeId nodeId;
+		bool      owned;
+	};
+
+	inline uint qHash(const QUaNodeIdKey &key, uint seed)
+	{
+		return UA_NodeId_hash(&key.nodeId) ^ seed;
+	}
+
+	struct QUaConverterCache
+	{
+		QCache<QUaNodeIdKey, QString     > nodeIdToString;
+		QCache<QString     , QUaNodeIdKey> nodeIdFromString;
+		QCache<QByteArray  , QString     > qualifiedNameToString;
+		QCache<QString     , QByteArray  > qualifiedNameFromString;
+		// container metatype id -> element metatype id (UnknownType if not a container)
+		// NOTE : filled lazily, registering QList<T> or QVector<T> upfront would take
+		//        user metatype ids and collide with the METATYPE_* ids
+		QHash<int, QMetaType::Type>          arrayTypes;
+	};
+
+	static std::atomic<int> g_cacheCapacity(QUA_CONVERTER_CACHE_CAPACITY);
+	// NOTE : stored instead of qMetaTypeId<QUaDateTime>, which would register it on first use
+	static std::atomic<int> g_dateTimeTypeId(QMetaType::UnknownType);
+
+	static QUaConverterCache & converterCache()
+	{
+		// NOTE : one cache per thread, so no locking is needed
+		static thread_local QUaConverterCache cache;
+		const int capacity = g_cacheCapacity.load(std::memory_order_relaxed);
+		if (cache.nodeIdToString.maxCost() != capacity)
+		{
+			cache.nodeIdToString         .setMaxCost(capacity);
+			cache.nodeIdFromString       .setMaxCost(capacity);
+			cache.qualifiedNameToString  .setMaxCost(capacity);
+			cache.qualifiedNameFromString.setMaxCost(capacity);
+		}
+		return cache;
+	}
+
+	int conversionCacheCapacity()
+	{
+		return g_cacheCapacity.load(std::memory_order_relaxed);
+	}
+
+	void setConversionCacheCapacity(const int & capacity)
+	{
+		Q_ASSERT(capacity >= 0);
+		// NOTE : caches of other threads are resized on their next conversion
+		g_cacheCapacity.store(qMax(0, capacity), std::memory_order_relaxed);
+	}
+
+	void removeNodeIdFromCache(const UA_NodeId & nodeId)
+	{
+		auto &cache = converterCache();
+		const QUaNodeIdKey key(nodeId, false);
+		auto strNodeId = cache.nodeIdToString.object(key);
+		if (strNodeId)
+		{
+			cache.nodeIdFromString.remove(QString(*strNodeId));
+		}
+		cache.nodeIdToString.remove(key);
+	}
+
+	void setDateTimeTypeId(const int & typeId)
+	{
+		g_dateTimeTypeId.store(typeId, std::memory_order_relaxed);
+	}
+
+	void clearConversionCache()
+	{
+		auto &cache = converterCache();
+		cache.nodeIdToString         .clear();
+		cache.nodeIdFromString       .clear();
+		cache.qualifiedNameToString  .clear();
+		cache.qualifiedNameFromString.clear();
+	}
+
+	static UA_NodeId nodeIdFromQStringInternal(const QString & name);
+	static QString   nodeIdToQStringInternal  (const UA_NodeId & id);
 
 	UA_NodeId nodeIdFromQString(const QString & name)
+	{
+		auto &cache = converterCache();
+		UA_NodeId nodeId;
+		auto cached = cache.nodeIdFromString.object(name);
+		if (cached)
+		{
+			// NOTE : caller owns returned node id
+			UA_NodeId_copy(&cached->nodeId, &nodeId);
+			return nodeId;
+		}
+		nodeId = nodeIdFromQStringInternal(name);
+		if (!UA_NodeId_isNull(&nodeId))
+		{
+			cache.nodeIdFromString.insert(name, new QUaNodeIdKey(nodeId));
+		}
+		return nodeId;
+	}
+
+	QString nodeIdToQString(const UA_NodeId & id)
+	{
+		auto &cache = converterCache();
+		const QUaNodeIdKey key(id, false);
+		auto cached = cache.nodeIdToString.object(key);
+		if (cached)
+		{
+			return *cached;
+		}
+		QString result = nodeIdToQStringInternal(id);
+		cache.nodeIdToString.insert(key, new QString(result));
+		return result;
+	}
+
+	static UA_NodeId nodeIdFromQStringInternal(const QString & name)
 	{
 		quint16 namespaceIndex;
 		QString identifierString;
@@ -65,14 +282,14 @@ namespace QUaTypesConverter {
 		return UA_NODEID_NULL;
 	}
 
-	QString nodeIdToQString(const UA_NodeId & id)
+	static QString nodeIdToQStringInternal(const UA_NodeId & id)
 	{
-		QString result = QString::fromLatin1("ns=%1;").arg(id.namespaceIndex);
+		QString result = QLatin1String("ns=") + QString::number(id.namespaceIndex) + QLatin1Char(';');
 
         switch (id.identifierType)
         {
 		case UA_NODEIDTYPE_NUMERIC:
-			result.append(QString::fromLatin1("i=%1").arg(id.identifier.numeric));
+			result.append(QLatin1String("i=")).append(QString::number(id.identifier.numeric));
 			break;
 		case UA_NODEIDTYPE_STRING:
 			result.append(QLatin1String("s="));
@@ -167,28 +384,106 @@ namespace QUaTypesConverter {
 		return UA_STRING_ALLOC(uaString.toUtf8().constData());
 	}
 
-	bool isQTypeArray(const QMetaType::Type & type)
+	QString uaQualifiedNameToQString(const UA_QualifiedName & qualifiedName)
 	{
-		auto strTypeName = QString(QMetaType::typeName(type));
-		if (strTypeName.contains("QList"  , Qt::CaseInsensitive) ||
-			strTypeName.contains("QVector", Qt::CaseInsensitive))
+		auto &cache = converterCache();
+		// NOTE : lookup without copying the name
+		const QByteArray key = QByteArray::fromRawData(
+			reinterpret_cast<const char *>(qualifiedName.name.data), 
+			static_cast<int>(qualifiedName.name.length)
+		);
+		auto cached = cache.qualifiedNameToString.object(key);
+		if (cached)
 		{
-			return true;
+			return *cached;
 		}
-		return false;
+		QString name = uaStringToQString(qualifiedName.name);
+		// stored key must own its data
+		cache.qualifiedNameToString.insert(QByteArray(key.constData(), key.size()), new QString(name));
+		return name;
 	}
 
-	QMetaType::Type getQArrayType(const QMetaType::Type & type)
+	UA_QualifiedName uaQualifiedNameFromQString(const QString & name, const quint16 & namespaceIndex/* = 1*/)
 	{
-		if (!QUaTypesConverter::isQTypeArray(type))
+		auto &cache = converterCache();
+		auto cached = cache.qualifiedNameFromString.object(name);
+		QByteArray byteName;
+		if (cached)
 		{
-			return QMetaType::UnknownType;
+			byteName = *cached;
 		}
-		auto strTypeName = QString(QMetaType::typeName(type));
-		strTypeName      = strTypeName.split("<").at(1);
-		strTypeName      = strTypeName.split(">").at(0);
-		auto byteName    = strTypeName.toUtf8();
-		return (QMetaType::Type)QMetaType::type(byteName.constData());
+		else
+		{
+			byteName = name.toUtf8();
+			cache.qualifiedNameFromString.insert(name, new QByteArray(byteName));
+		}
+		UA_QualifiedName qualifiedName;
+		UA_QualifiedName_init(&qualifiedName);
+		qualifiedName.namespaceIndex = namespaceIndex;
+		if (byteName.size() > 0 &&
+			UA_ByteString_allocBuffer(&qualifiedName.name, static_cast<size_t>(byteName.size())) == UA_STATUSCODE_GOOD)
+		{
+			std::memcpy(qualifiedName.name.data, byteName.constData(), static_cast<size_t>(byteName.size()));
+		}
+		return qualifiedName;
+	}
+
+	// returns true if type is a container, elemType is then set to the element type
+	static bool arrayElementType(const QMetaType::Type & type, QMetaType::Type & elemType)
+	{
+		// builtin aliases such as QStringList are not considered containers
+		if (type < QMetaType::User)
+		{
+			elemType = QMetaType::UnknownType;
+			return false;
+		}
+		// known types are resolved without string parsing
+		auto &arrayTypes = converterCache().arrayTypes;
+		auto iter = arrayTypes.constFind(type);
+		if (iter != arrayTypes.constEnd())
+		{
+			elemType = iter.value();
+			return elemType != QMetaType::UnknownType;
+		}
+		const char * typeName = QMetaType::typeName(type);
+		if (!typeName)
+		{
+			// do not cache, id is not registered (yet)
+			elemType = QMetaType::UnknownType;
+			return false;
+		}
+		auto strTypeName = QString(typeName);
+		bool isArray = 
+			strTypeName.contains("QList"  , Qt::CaseInsensitive) ||
+			strTypeName.contains("QVector", Qt::CaseInsensitive);
+		elemType = QMetaType::UnknownType;
+		if (isArray)
+		{
+			strTypeName   = strTypeName.split("<").at(1);
+			strTypeName   = strTypeName.split(">").at(0);
+			auto byteName = strTypeName.toUtf8();
+			// NOTE : lookup only, does not register element type
+			elemType = (QMetaType::Type)QMetaType::type(byteName.constData());
+		}
+		// do not cache if element type is not registered (yet)
+		if (!isArray || elemType != QMetaType::UnknownType)
+		{
+			arrayTypes.insert(type, elemType);
+		}
+		return isArray;
+	}
+
+	bool isQTypeArray(const QMetaType::Type & type)
+	{
+		QMetaType::Type elemType;
+		return arrayElementType(type, elemType);
+	}
+
+	QMetaType::Type getQArrayType(const QMetaType::Type & type)
+	{
+		QMetaType::Type elemType;
+		arrayElementType(type, elemType);
+		return elemType;
 	}
 
 	bool isSupportedQType(const QMetaType::Type & type)
@@ -227,6 +522,31 @@ namespace QUaTypesConverter {
 		}
 	}
 
+	QVector<quint32> getQVariantDimensions(const QVariant & var, QMetaType::Type * leafType/* = nullptr*/)
+	{
+		QVector<quint32> dims;
+		QVariant level = var;
+		QMetaType::Type type = static_cast<QMetaType::Type>(level.type());
+		while (level.canConvert<QVariantList>())
+		{
+			auto iter = level.value<QSequentialIterable>();
+			dims.append(static_cast<quint32>(iter.size()));
+			// empty level, type of leaves is unknown
+			if (iter.size() <= 0)
+			{
+				type = QMetaType::UnknownType;
+				break;
+			}
+			level = iter.at(0);
+			type  = static_cast<QMetaType::Type>(level.type());
+		}
+		if (leafType)
+		{
+			*leafType = type;
+		}
+		return dims;
+	}
+
 	UA_NodeId uaTypeNodeIdFromQType(const QMetaType::Type & type)
 	{
 		switch (type)
@@ -286,66 +606,17 @@ namespace QUaTypesConverter {
 
 	const UA_DataType * uaTypeFromQType(const QMetaType::Type & type)
 	{
-		switch (type)
+		auto converter = fromQtConverter(type);
+		if (!converter || !converter->uaType)
 		{
-		case QMetaType::UnknownType:
-			return &UA_TYPES[UA_TYPES_VARIANT];       // 23 : UA_Variant   : QVariant(QMetaType::UnknownType)
-		case QMetaType::Bool:
-			return &UA_TYPES[UA_TYPES_BOOLEAN];       // 0  : UA_Boolean   : bool
-		case QMetaType::Char:
-		case QMetaType::SChar:
-			return &UA_TYPES[UA_TYPES_SBYTE];         // 1  : UA_SByte     : int8_t
-		case QMetaType::UChar:
-			return &UA_TYPES[UA_TYPES_BYTE];          // 2  : UA_Byte      : uint8_t
-		case QMetaType::Short:
-			return &UA_TYPES[UA_TYPES_INT16];         // 3  : UA_Int16     : int16_t
-		case QMetaType::UShort:
-			return &UA_TYPES[UA_TYPES_UINT16];        // 4  : UA_UInt16    : uint16_t
-		case QMetaType::Int:
-			return &UA_TYPES[UA_TYPES_INT32];         // 5  : UA_Int32     : int32_t
-		case QMetaType::UInt:
-			return &UA_TYPES[UA_TYPES_UINT32];        // 6  : UA_UInt32    : uint32_t
-		case QMetaType::Long:
-		case QMetaType::LongLong:
-			return &UA_TYPES[UA_TYPES_INT64];         // 7  : UA_Int64     : int64_t
-		case QMetaType::ULong:
-		case QMetaType::ULongLong:
-			return &UA_TYPES[UA_TYPES_UINT64];        // 8  : UA_UInt64    : uint64_t
-		case QMetaType::Float:
-			return &UA_TYPES[UA_TYPES_FLOAT];         // 9  : UA_Float     : float
-		case QMetaType::Double:
-			return &UA_TYPES[UA_TYPES_DOUBLE];        // 10 : UA_Double    : double 
-		case QMetaType::QString:
-			return &UA_TYPES[UA_TYPES_STRING];        // 11 : UA_String    : { size_t length;  UA_Byte *data; }
-		case QMetaType::QDateTime:
-			return &UA_TYPES[UA_TYPES_DATETIME];      // 12 : UA_DateTime  : int64_t
-		case QMetaType::QUuid:
-			return &UA_TYPES[UA_TYPES_GUID];          // 13 : UA_Guid      : { UA_UInt32 data1; UA_UInt16 data2; UA_UInt16 data3; UA_Byte data4[8]; }
-		case QMetaType::QByteArray:
-			return &UA_TYPES[UA_TYPES_BYTESTRING];    // 14 : UA_ByteString : UA_String * A sequence of octets. */
-		case METATYPE_NODEID:
-			return &UA_TYPES[UA_TYPES_NODEID];        // 16 : UA_NodeId : { ... }
-		case METATYPE_LOCALIZEDTEXT:
-			return &UA_TYPES[UA_TYPES_LOCALIZEDTEXT];    // 20  : UA_LocalizedText : { UA_String locale; UA_String text; }
-#ifdef UA_TYPES_IMAGEPNG
-		case METATYPE_IMAGE:
-			return &UA_TYPES[UA_TYPES_IMAGEPNG];
-#endif
-#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
-		case METATYPE_TIMEZONEDATATYPE:
-			return &UA_TYPES[UA_TYPES_TIMEZONEDATATYPE]; // 258 : UA_TimeZoneDataType { UA_Int16 offset; UA_Boolean daylightSavingInOffset; }
-		case METATYPE_CHANGESTRUCTUREDATATYPE:
-			return &UA_TYPES[UA_TYPES_MODELCHANGESTRUCTUREDATATYPE]; // 267 : UA_ModelChangeStructureDataType { UA_NodeId affected; UA_NodeId affectedType; UA_Byte verb; }
-#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
-		default:
 			Q_ASSERT_X(false, "uaTypeFromQType", "Unsupported datatype");
 			return nullptr;
 		}
+		return converter->uaType;
 	}
 
 	UA_Variant uaVariantFromQVariant(const QVariant & var, QMetaType::Type qtType/* = QMetaType::UnknownType*/)
 	{
-		// TODO : support multidimentional arrays
 		// copy input type before gets modified
 		QMetaType::Type qtTypeIn = qtType;
 		// get qt type from variant
@@ -353,73 +624,31 @@ namespace QUaTypesConverter {
 		{
 			qtType = static_cast<QMetaType::Type>(var.type());
 		}
-		//QMetaType::Type qtType;
-		const UA_DataType * uaType = nullptr;
-		// fix qt type if array
-		if (var.canConvert<QVariantList>())
+		const int varType = var.userType();
+		// integer timestamps are converted without going through QDateTime
+		const int dateTimeTypeId = g_dateTimeTypeId.load(std::memory_order_relaxed);
+		if (dateTimeTypeId != QMetaType::UnknownType && varType == dateTimeTypeId)
 		{
-			qtType = QMetaType::QVariantList;
+			const UA_DateTime ticks = var.value<QUaDateTime>().ticks();
+			UA_Variant open62541value;
+			UA_Variant_setScalarCopy(&open62541value, &ticks, &UA_TYPES[UA_TYPES_DATETIME]);
+			return open62541value;
 		}
-		else
+		// builtin scalars can never be iterated, so skip the costly canConvert check for them
+		// NOTE : user types are not looked up because their ids can overlap the custom metatypes
+		auto varConverter = varType < QMetaType::User ? fromQtConverter(varType) : nullptr;
+		if ((!varConverter || !varConverter->scalar) && var.canConvert<QVariantList>())
 		{
-			uaType = uaTypeFromQType(qtType);
+			return uaVariantFromQVariantArray(var, qtTypeIn);
 		}
-		// get ua type and call respective method
-		switch (qtType)
+		// call respective scalar converter
+		auto converter = fromQtConverter(qtType);
+		if (!converter || !converter->scalar)
 		{
-		case QMetaType::UnknownType:   // 23 : UA_Variant   : QVariant(QMetaType::UnknownType)
-			return uaVariantFromQVariantScalar<UA_Variant   , QVariant  >(var, uaType);
-		case QMetaType::Bool:          // 0  : UA_Boolean   : bool
-			return uaVariantFromQVariantScalar<UA_Boolean   , bool      >(var, uaType);
-		case QMetaType::Char:
-		case QMetaType::SChar:         // 1  : UA_SByte     : int8_t
-			return uaVariantFromQVariantScalar<UA_SByte     , char      >(var, uaType);
-		case QMetaType::UChar:         // 2  : UA_Byte      : uint8_t
-			return uaVariantFromQVariantScalar<UA_Byte      , uchar     >(var, uaType);
-		case QMetaType::Short:         // 3  : UA_Int16     : int16_t
-			return uaVariantFromQVariantScalar<UA_Int16     , qint16    >(var, uaType);
-		case QMetaType::UShort:        // 4  : UA_UInt16    : uint16_t
-			return uaVariantFromQVariantScalar<UA_UInt16    , quint16   >(var, uaType);
-		case QMetaType::Int:           // 5  : UA_Int32     : int32_t
-			return uaVariantFromQVariantScalar<UA_Int32     , qint32    >(var, uaType);
-		case QMetaType::UInt:          // 6  : UA_UInt32    : uint32_t
-			return uaVariantFromQVariantScalar<UA_UInt32    , quint32   >(var, uaType);
-		case QMetaType::Long:
-		case QMetaType::LongLong:      // 7  : UA_Int64     : int64_t
-			return uaVariantFromQVariantScalar<UA_Int64     , int64_t   >(var, uaType);
-		case QMetaType::ULong:
-		case QMetaType::ULongLong:     // 8  : UA_UInt64    : uint64_t
-			return uaVariantFromQVariantScalar<UA_UInt64    , uint64_t  >(var, uaType);
-		case QMetaType::Float:         // 9  : UA_Float     : float
-			return uaVariantFromQVariantScalar<UA_Float     , float     >(var, uaType);
-		case QMetaType::Double:        // 10 : UA_Double    : double 
-			return uaVariantFromQVariantScalar<UA_Double    , double    >(var, uaType);
-		case QMetaType::QString:       // 11 : UA_String    : { size_t length;  UA_Byte *data; }
-			return uaVariantFromQVariantScalar<UA_String    , QString   >(var, uaType);
-		case QMetaType::QDateTime:     // 12 : UA_DateTime  : int64_t
-			return uaVariantFromQVariantScalar<UA_DateTime  , QDateTime >(var, uaType);
-		case QMetaType::QUuid:         // 13 : UA_Guid      : { UA_UInt32 data1; UA_UInt16 data2; UA_UInt16 data3; UA_Byte data4[8]; }
-			return uaVariantFromQVariantScalar<UA_Guid      , QUuid     >(var, uaType);
-		case QMetaType::QByteArray:    // 14 : UA_ByteString : UA_String * A sequence of octets. */
-			return uaVariantFromQVariantScalar<UA_ByteString, QByteArray>(var, uaType);
-		case METATYPE_NODEID:          // 16 : UA_NodeId : { ... }
-			return uaVariantFromQVariantScalar<UA_NodeId    , QString>(var, uaType);
-		case METATYPE_LOCALIZEDTEXT:    // 20 : UA_LocalizedText : { UA_String locale; UA_String text; }
-			return uaVariantFromQVariantScalar<UA_LocalizedText, QString>(var, uaType);
-		case METATYPE_IMAGE:
-			return uaVariantFromQVariantScalar<UA_ByteString  , QByteArray>(var, uaType);
-#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
-		case METATYPE_TIMEZONEDATATYPE: // 258 : UA_TimeZoneDataType { UA_Int16 offset; UA_Boolean daylightSavingInOffset; }
-			return uaVariantFromQVariantScalar<UA_TimeZoneDataType, QTimeZone>(var, uaType);
-		case METATYPE_CHANGESTRUCTUREDATATYPE: // 267 : UA_ModelChangeStructureDataType { UA_NodeId affected; UA_NodeId affectedType; UA_Byte verb; }
-			return uaVariantFromQVariantScalar<UA_ModelChangeStructureDataType, QUaChangeStructureDataType>(var, uaType);
-#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
-		case QMetaType::QVariantList:   // UA_Array
-			return uaVariantFromQVariantArray(var, qtTypeIn);
-		default:
 			Q_ASSERT_X(false, "uaVariantFromQVariant", "Unsupported datatype");
 			return UA_Variant();
 		}
+		return converter->scalar(var, converter->uaType);
 	}
 
 	template<typename TARGETTYPE, typename QTTYPE>
@@ -457,6 +686,12 @@ namespace QUaTypesConverter {
 		const QDateTime uaEpochStart(QDate(1601, 1, 1), QTime(0, 0), Qt::UTC);
 		*ptr = UA_DATETIME_MSEC * (value.toMSecsSinceEpoch() - uaEpochStart.toMSecsSinceEpoch());
 	}
+	// specialization (QUaDateTime)
+	template<>
+	void uaVariantFromQVariantScalar<UA_DateTime, QUaDateTime>(const QUaDateTime &value, UA_DateTime *ptr)
+	{
+		*ptr = value.ticks();
+	}
 	// specialization (QString)
 	template<>
 	void uaVariantFromQVariantScalar<UA_String, QString>(const QString &value, UA_String *ptr)
@@ -519,60 +754,114 @@ namespace QUaTypesConverter {
 	{
 		// assume that the type of the first elem of the array is the type of all the array
 		auto iter = var.value<QSequentialIterable>();
+		// nested lists are multidimensional arrays
+		if (iter.size() > 0 && iter.at(0).canConvert<QVariantList>())
+		{
+			return uaVariantFromQVariantMatrix(var, qtType == QMetaType::QVariantList ? QMetaType::UnknownType : qtType);
+		}
 		// fix for forcing arrays of custom types
 		if (qtType == QMetaType::UnknownType)
 		{
 			qtType = static_cast<QMetaType::Type>(iter.at(0).type());
 		}
-		auto uaType = uaTypeFromQType(qtType);
-		switch (qtType)
+		// call respective array converter
+		auto converter = fromQtConverter(qtType);
+		if (!converter || !converter->array)
 		{
-		case QMetaType::UnknownType:   // 23 : UA_Variant   : QVariant(QMetaType::UnknownType)
-			return uaVariantFromQVariantArray<UA_Variant   , QVariant  >(var, uaType);
-		case QMetaType::Bool:          // 0  : UA_Boolean   : bool
-			return uaVariantFromQVariantArray<UA_Boolean   , bool      >(var, uaType);
-		case QMetaType::Char:
-		case QMetaType::SChar:         // 1  : UA_SByte     : int8_t
-			return uaVariantFromQVariantArray<UA_SByte     , char      >(var, uaType);
-		case QMetaType::UChar:         // 2  : UA_Byte      : uint8_t
-			return uaVariantFromQVariantArray<UA_Byte      , uchar     >(var, uaType);
-		case QMetaType::Short:         // 3  : UA_Int16     : int16_t
-			return uaVariantFromQVariantArray<UA_Int16     , qint16    >(var, uaType);
-		case QMetaType::UShort:        // 4  : UA_UInt16    : uint16_t
-			return uaVariantFromQVariantArray<UA_UInt16    , quint16   >(var, uaType);
-		case QMetaType::Int:           // 5  : UA_Int32     : int32_t
-			return uaVariantFromQVariantArray<UA_Int32     , qint32    >(var, uaType);
-		case QMetaType::UInt:          // 6  : UA_UInt32    : uint32_t
-			return uaVariantFromQVariantArray<UA_UInt32    , quint32   >(var, uaType);
-		case QMetaType::Long:
-		case QMetaType::LongLong:      // 7  : UA_Int64     : int64_t
-			return uaVariantFromQVariantArray<UA_Int64     , int64_t   >(var, uaType);
-		case QMetaType::ULong:
-		case QMetaType::ULongLong:     // 8  : UA_UInt64    : uint64_t
-			return uaVariantFromQVariantArray<UA_UInt64    , uint64_t  >(var, uaType);
-		case QMetaType::Float:         // 9  : UA_Float     : float
-			return uaVariantFromQVariantArray<UA_Float     , float     >(var, uaType);
-		case QMetaType::Double:        // 10 : UA_Double    : double 
-			return uaVariantFromQVariantArray<UA_Double    , double    >(var, uaType);
-		case QMetaType::QString:       // 11 : UA_String    : { size_t length;  UA_Byte *data; }
-			return uaVariantFromQVariantArray<UA_String    , QString   >(var, uaType);
-		case QMetaType::QDateTime:     // 12 : UA_DateTime  : int64_t
-			return uaVariantFromQVariantArray<UA_DateTime  , QDateTime >(var, uaType);
-		case QMetaType::QUuid:         // 13 : UA_Guid      : { UA_UInt32 data1; UA_UInt16 data2; UA_UInt16 data3; UA_Byte data4[8]; }
-			return uaVariantFromQVariantArray<UA_Guid      , QUuid     >(var, uaType);
-		case QMetaType::QByteArray:    // 14 : UA_ByteString : UA_String * A sequence of octets. */
-			return uaVariantFromQVariantArray<UA_ByteString, QByteArray>(var, uaType);
-#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
-		case METATYPE_CHANGESTRUCTUREDATATYPE: // 267 : UA_ModelChangeStructureDataType { UA_NodeId affected; UA_NodeId affectedType; UA_Byte verb; }
-			return uaVariantFromQVariantArray<UA_ModelChangeStructureDataType, QUaChangeStructureDataType>(var, uaType);
-#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
-		case QMetaType::QVariantList:  // UA_Array
-			Q_ASSERT_X(false, "uaVariantFromQVariantArray", "Unsupported multidimentional arrays");
-			return UA_Variant();
-		default:
 			Q_ASSERT_X(false, "uaVariantFromQVariantArray", "Unsupported datatype");
 			return UA_Variant();
 		}
+		return converter->array(var, converter->uaType);
+	}
+
+	// names of the qt containers of SRCTYPE, matched by name because qMetaTypeId
+	// of the container would register it and could take the hard-coded METATYPE_* ids
+	template<typename SRCTYPE>
+	struct QContainerNames
+	{
+		static const QByteArray &vector()
+		{
+			static const QByteArray name = "QVector<" + QByteArray(QMetaType::typeName(qMetaTypeId<SRCTYPE>())) + ">";
+			return name;
+		}
+		static const QByteArray &list()
+		{
+			static const QByteArray name = "QList<" + QByteArray(QMetaType::typeName(qMetaTypeId<SRCTYPE>())) + ">";
+			return name;
+		}
+	};
+
+	// copy a numeric qt container holding SRCTYPE elements into a new ua array
+	template<typename TARGETTYPE, typename SRCTYPE>
+	bool uaArrayFromQContainer(const QVariant & var, const UA_DataType * type, TARGETTYPE ** arr, size_t * size)
+	{
+		const int varType = var.userType();
+		if (varType < QMetaType::User)
+		{
+			return false;
+		}
+		const char * typeName = QMetaType::typeName(varType);
+		if (!typeName)
+		{
+			return false;
+		}
+		if (QContainerNames<SRCTYPE>::vector() == typeName)
+		{
+			// contiguous, single bulk copy
+			const QVector<SRCTYPE> * vect = static_cast<const QVector<SRCTYPE> *>(var.constData());
+			*size = static_cast<size_t>(vect->size());
+			if (*size == 0)
+			{
+				return false;
+			}
+			*arr = static_cast<TARGETTYPE *>(UA_Array_new(*size, type));
+			numericArrayCopy(*arr, vect->constData(), *size);
+			return true;
+		}
+		if (QContainerNames<SRCTYPE>::list() == typeName)
+		{
+			// not necessarily contiguous, but still no per-element variants
+			const QList<SRCTYPE> * list = static_cast<const QList<SRCTYPE> *>(var.constData());
+			*size = static_cast<size_t>(list->size());
+			if (*size == 0)
+			{
+				return false;
+			}
+			*arr = static_cast<TARGETTYPE *>(UA_Array_new(*size, type));
+			for (int i = 0; i < list->size(); i++)
+			{
+				(*arr)[i] = numericCast<TARGETTYPE, SRCTYPE>(list->at(i));
+			}
+			return true;
+		}
+		return false;
+	}
+
+	template<typename TARGETTYPE>
+	bool uaArrayFromAnyQContainer(const QVariant &, const UA_DataType *, TARGETTYPE **, size_t *)
+	{
+		return false;
+	}
+
+	template<typename TARGETTYPE, typename SRCTYPE, typename... OTHERTYPES>
+	bool uaArrayFromAnyQContainer(const QVariant & var, const UA_DataType * type, TARGETTYPE ** arr, size_t * size)
+	{
+		return uaArrayFromQContainer<TARGETTYPE, SRCTYPE>(var, type, arr, size) ||
+			uaArrayFromAnyQContainer<TARGETTYPE, OTHERTYPES...>(var, type, arr, size);
+	}
+
+	template<typename TARGETTYPE, typename QTTYPE>
+	bool uaArrayFromNumericQContainer(const QVariant &, const UA_DataType *, TARGETTYPE **, size_t *, std::false_type)
+	{
+		return false;
+	}
+
+	template<typename TARGETTYPE, typename QTTYPE>
+	bool uaArrayFromNumericQContainer(const QVariant & var, const UA_DataType * type, TARGETTYPE ** arr, size_t * size, std::true_type)
+	{
+		// try the declared element type first, then widen or narrow from the other numeric types
+		return uaArrayFromAnyQContainer<TARGETTYPE, QTTYPE,
+			double, float, qint32, quint32, qint64, quint64, qint16, quint16, uchar, signed char>(var, type, arr, size);
 	}
 
 	template<typename TARGETTYPE, typename QTTYPE>
@@ -580,22 +869,29 @@ namespace QUaTypesConverter {
 	{
 		UA_Variant retVar;
 		UA_Variant_init(&retVar);
-		// if empty
-		auto iter = var.value<QSequentialIterable>();
-		if (iter.size() <= 0)
+		TARGETTYPE *arr  = nullptr;
+		size_t      size = 0;
+		// numeric containers are copied in bulk, without going through per-element variants
+		if (!uaArrayFromNumericQContainer<TARGETTYPE, QTTYPE>(var, type, &arr, &size, std::is_arithmetic<TARGETTYPE>()))
 		{
-			return retVar;
-		}
-		// instantiate ua array
-        TARGETTYPE *arr = static_cast<TARGETTYPE *>(UA_Array_new(static_cast<size_t>(iter.size()), type));
-		// copy values
-		for (int i = 0; i < iter.size(); i++)
-		{
-			uaVariantFromQVariantScalar<TARGETTYPE, QTTYPE>(iter.at(i).value<QTTYPE>(), &arr[i]);
+			// if empty
+			auto iter = var.value<QSequentialIterable>();
+			if (iter.size() <= 0)
+			{
+				return retVar;
+			}
+			// instantiate ua array
+			size = static_cast<size_t>(iter.size());
+			arr  = static_cast<TARGETTYPE *>(UA_Array_new(size, type));
+			// copy values
+			for (int i = 0; i < iter.size(); i++)
+			{
+				uaVariantFromQVariantScalar<TARGETTYPE, QTTYPE>(iter.at(i).value<QTTYPE>(), &arr[i]);
+			}
 		}
 		// set the array to the ua variant
-		// TODO : support multidimentional array
-        UA_Variant_setArray(&retVar, arr, static_cast<size_t>(iter.size()), type);
+		// NOTE : multidimentional shape is set by uaVariantFromQVariantMatrix
+        UA_Variant_setArray(&retVar, arr, size, type);
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
 		// NOTE : UAExpert requires list of changes to be an array (not matrix)
 		if (!std::is_same<QTTYPE, QUaChangeStructureDataType>::value)
@@ -604,7 +900,7 @@ namespace QUaTypesConverter {
 		// NOTE : need to disable code below if using rank and arrayDim to set size and shape of data
 		//        (for UAExpert to detect if array or matrix)
 			retVar.arrayDimensions     = static_cast<UA_UInt32 *>(UA_Array_new(1, &UA_TYPES[UA_TYPES_UINT32]));
-			retVar.arrayDimensions[0]  = static_cast<UA_UInt32>(iter.size());
+			retVar.arrayDimensions[0]  = static_cast<UA_UInt32>(size);
 			retVar.arrayDimensionsSize = static_cast<size_t>(1);
 #ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
 		}
@@ -635,7 +931,7 @@ namespace QUaTypesConverter {
 		}
 		// set the array to the ua variant
 		UA_Variant_setArray(&retVar, arr, static_cast<size_t>(iter.size()), type);
-		// TODO : support multidimentional array
+		// NOTE : multidimentional shape is set by uaVariantFromQVariantMatrix
 		retVar.arrayDimensions     = static_cast<UA_UInt32 *>(UA_Array_new(1, &UA_TYPES[UA_TYPES_UINT32]));
 		retVar.arrayDimensions[0]  = static_cast<UA_UInt32>(iter.size());
 		retVar.arrayDimensionsSize = static_cast<size_t>(1);
@@ -643,6 +939,68 @@ namespace QUaTypesConverter {
 		return retVar;
 	}
 
+	static bool flattenQVariantMatrix(const QVariant & var, const QVector<quint32> & dims, const int & level, QVariantList & flat)
+	{
+		auto iter = var.value<QSequentialIterable>();
+		if (static_cast<quint32>(iter.size()) != dims.at(level))
+		{
+			return false;
+		}
+		const bool isLast = level == dims.size() - 1;
+		for (int i = 0; i < iter.size(); i++)
+		{
+			if (isLast)
+			{
+				flat.append(iter.at(i));
+				continue;
+			}
+			if (!iter.at(i).canConvert<QVariantList>() ||
+				!flattenQVariantMatrix(iter.at(i), dims, level + 1, flat))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	UA_Variant uaVariantFromQVariantMatrix(const QVariant & var, QMetaType::Type qtType/* = QMetaType::UnknownType*/)
+	{
+		UA_Variant retVar;
+		UA_Variant_init(&retVar);
+		// shape is given by the first element of each level
+		auto dims = getQVariantDimensions(var);
+		int size = dims.isEmpty() ? 0 : 1;
+		for (int i = 0; i < dims.size(); i++)
+		{
+			size *= static_cast<int>(dims.at(i));
+		}
+		if (size == 0)
+		{
+			return retVar;
+		}
+		// flatten in row-major order, all levels must have the same size
+		QVariantList flat;
+		flat.reserve(size);
+		if (!flattenQVariantMatrix(var, dims, 0, flat))
+		{
+			Q_ASSERT_X(false, "uaVariantFromQVariantMatrix", "Multidimentional arrays must be rectangular");
+			return retVar;
+		}
+		// convert as one dimensional array
+		retVar = uaVariantFromQVariantArray(flat, qtType);
+		if (retVar.data == nullptr)
+		{
+			return retVar;
+		}
+		// replace shape
+		UA_Array_delete(retVar.arrayDimensions, retVar.arrayDimensionsSize, &UA_TYPES[UA_TYPES_UINT32]);
+		const size_t dimsSize = static_cast<size_t>(dims.size());
+		retVar.arrayDimensions     = static_cast<UA_UInt32 *>(UA_Array_new(dimsSize, &UA_TYPES[UA_TYPES_UINT32]));
+		retVar.arrayDimensionsSize = dimsSize;
+		numericArrayCopy(retVar.arrayDimensions, dims.constData(), dimsSize);
+		return retVar;
+	}
+
     UA_Boolean UA_NodeId_equal_helper(const UA_NodeId *n1, const UA_NodeId n2)
     {
         return UA_NodeId_equal(n1, &n2);
@@ -755,118 +1113,37 @@ namespace QUaTypesConverter {
 		if (uaType == nullptr) {
 			return QMetaType::UnknownType;
 		}
-		switch (uaType->typeIndex) {
-		case UA_TYPES_VARIANT:
-			return QMetaType::UnknownType;
-		case UA_TYPES_BOOLEAN:
-			return QMetaType::Bool;
-		case UA_TYPES_SBYTE:
-			return QMetaType::SChar;
-		case UA_TYPES_BYTE:
-			return QMetaType::UChar;
-		case UA_TYPES_INT16:
-			return QMetaType::Short;
-		case UA_TYPES_UINT16:
-			return QMetaType::UShort;
-		case UA_TYPES_INT32:
-			return QMetaType::Int;
-		case UA_TYPES_UINT32:
-			return QMetaType::UInt;
-		case UA_TYPES_INT64:
-			return QMetaType::LongLong;
-		case UA_TYPES_UINT64:
-			return QMetaType::ULongLong;
-		case UA_TYPES_FLOAT:
-			return QMetaType::Float;
-		case UA_TYPES_DOUBLE:
-			return QMetaType::Double;
-		case UA_TYPES_STRING:
-			return QMetaType::QString;	
-		case UA_TYPES_DATETIME:
-			return QMetaType::QDateTime;
-		case UA_TYPES_GUID:
-			return QMetaType::QUuid;
-		case UA_TYPES_BYTESTRING:
-			return QMetaType::QByteArray;
-		case UA_TYPES_NODEID:
-			return METATYPE_NODEID;
-		case UA_TYPES_LOCALIZEDTEXT:
-			return METATYPE_LOCALIZEDTEXT;
-#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
-		case UA_TYPES_TIMEZONEDATATYPE:
-			return METATYPE_TIMEZONEDATATYPE;
-		case UA_TYPES_MODELCHANGESTRUCTUREDATATYPE:
-			return METATYPE_CHANGESTRUCTUREDATATYPE;
-#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
-		default:
+		auto converter = toQtConverter(uaType);
+		if (!converter || !converter->scalar)
+		{
 			Q_ASSERT_X(false, "uaTypeToQType", "Unsupported datatype");
 			return QMetaType::UnknownType;
 		}
+		return converter->qtType;
 	}
 
 	QVariant uaVariantToQVariant(const UA_Variant & uaVariant)
 	{
-		// TODO : support multidimentional arrays
-
 		if (uaVariant.type == nullptr) {
 			return QVariant();
 		}
 		// first check if array
 		if (!UA_Variant_isScalar(&uaVariant))
 		{
+			if (uaVariant.arrayDimensionsSize > 1)
+			{
+				return uaVariantToQVariantMatrix(uaVariant);
+			}
 			return uaVariantToQVariantArray(uaVariant);
 		}
 		// handle scalar
-		switch (uaVariant.type->typeIndex) {
-		case UA_TYPES_VARIANT:
-			return uaVariantToQVariantScalar<QVariant   , UA_Variant   >(uaVariant, QMetaType::UnknownType);
-		case UA_TYPES_BOOLEAN:
-			return uaVariantToQVariantScalar<bool       , UA_Boolean   >(uaVariant, QMetaType::Bool);
-		case UA_TYPES_SBYTE:										   
-			return uaVariantToQVariantScalar<signed char, UA_SByte     >(uaVariant, QMetaType::SChar);
-		case UA_TYPES_BYTE:											   
-			return uaVariantToQVariantScalar<uchar      , UA_Byte      >(uaVariant, QMetaType::UChar);
-		case UA_TYPES_INT16:										   
-			return uaVariantToQVariantScalar<qint16     , UA_Int16     >(uaVariant, QMetaType::Short);
-		case UA_TYPES_UINT16:										   
-			return uaVariantToQVariantScalar<quint16    , UA_UInt16    >(uaVariant, QMetaType::UShort);
-		case UA_TYPES_INT32:										   
-			return uaVariantToQVariantScalar<qint32     , UA_Int32     >(uaVariant, QMetaType::Int);
-		case UA_TYPES_UINT32:										   
-			return uaVariantToQVariantScalar<quint32    , UA_UInt32    >(uaVariant, QMetaType::UInt);
-		case UA_TYPES_INT64:										   
-			return uaVariantToQVariantScalar<int64_t    , UA_Int64     >(uaVariant, QMetaType::LongLong);
-		case UA_TYPES_UINT64:										   
-			return uaVariantToQVariantScalar<uint64_t   , UA_UInt64    >(uaVariant, QMetaType::ULongLong);
-		case UA_TYPES_FLOAT:										   
-			return uaVariantToQVariantScalar<float      , UA_Float     >(uaVariant, QMetaType::Float);
-		case UA_TYPES_DOUBLE:										   
-			return uaVariantToQVariantScalar<double     , UA_Double    >(uaVariant, QMetaType::Double);
-		case UA_TYPES_STRING:										   
-			return uaVariantToQVariantScalar<QString    , UA_String    >(uaVariant, QMetaType::QString);
-		case UA_TYPES_DATETIME:										   
-			return uaVariantToQVariantScalar<QDateTime  , UA_DateTime  >(uaVariant, QMetaType::QDateTime);
-		case UA_TYPES_GUID:											   
-			return uaVariantToQVariantScalar<QUuid      , UA_Guid      >(uaVariant, QMetaType::QUuid);
-		case UA_TYPES_BYTESTRING:
-			return uaVariantToQVariantScalar<QByteArray , UA_ByteString>(uaVariant, QMetaType::QByteArray);
-		case UA_TYPES_UTCTIME:
-			// NOTE : typedef UA_DateTime UA_UtcTime;
-			return uaVariantToQVariantScalar<QDateTime  , UA_DateTime  >(uaVariant, QMetaType::QDateTime);
-		case UA_TYPES_NODEID:
-			return uaVariantToQVariantScalar<QString    , UA_NodeId    >(uaVariant, METATYPE_NODEID);
-		case UA_TYPES_LOCALIZEDTEXT:
-			return uaVariantToQVariantScalar<QString    , UA_LocalizedText   >(uaVariant, METATYPE_LOCALIZEDTEXT);
-#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
-		case UA_TYPES_TIMEZONEDATATYPE:
-			return uaVariantToQVariantScalar<QTimeZone  , UA_TimeZoneDataType>(uaVariant, METATYPE_TIMEZONEDATATYPE);
-		case UA_TYPES_MODELCHANGESTRUCTUREDATATYPE:
-			return uaVariantToQVariantScalar<QUaChangeStructureDataType, UA_ModelChangeStructureDataType>(uaVariant, METATYPE_CHANGESTRUCTUREDATATYPE);
-#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
-		default:
+		auto converter = toQtConverter(uaVariant.type);
+		if (!converter || !converter->scalar)
+		{
 			Q_ASSERT_X(false, "uaVariantToQVariant", "Unsupported datatype");
+			return QVariant();
 		}
-		return QVariant();
+		return converter->scalar(uaVariant, converter->qtType);
 	}
 
 	QVariant uaVariantToQVariantArray(const UA_Variant  &uaVariant, const ArrayType &arrType/* = ArrayType::QList*/)
@@ -890,47 +1167,13 @@ namespace QUaTypesConverter {
 			return QVariant();
 		}
 		// handle array
-		switch (uaVariant.type->typeIndex) {
-		case UA_TYPES_VARIANT:
-            return uaVariantToQVariantArray<QList<QVariant>   , UA_Variant   >(uaVariant, QMetaType::UnknownType);
-		case UA_TYPES_BOOLEAN:
-            return uaVariantToQVariantArray<QList<bool>       , UA_Boolean   >(uaVariant, QMetaType::Bool);
-		case UA_TYPES_SBYTE:										   
-            return uaVariantToQVariantArray<QList<signed char>, UA_SByte     >(uaVariant, QMetaType::SChar);
-		case UA_TYPES_BYTE:											   
-            return uaVariantToQVariantArray<QList<uchar>      , UA_Byte      >(uaVariant, QMetaType::UChar);
-		case UA_TYPES_INT16:										   
-            return uaVariantToQVariantArray<QList<qint16>     , UA_Int16     >(uaVariant, QMetaType::Short);
-		case UA_TYPES_UINT16:										   
-            return uaVariantToQVariantArray<QList<quint16>    , UA_UInt16    >(uaVariant, QMetaType::UShort);
-		case UA_TYPES_INT32:										   
-            return uaVariantToQVariantArray<QList<qint32>     , UA_Int32     >(uaVariant, QMetaType::Int);
-		case UA_TYPES_UINT32:										   
-            return uaVariantToQVariantArray<QList<quint32>    , UA_UInt32    >(uaVariant, QMetaType::UInt);
-		case UA_TYPES_INT64:										   
-            return uaVariantToQVariantArray<QList<int64_t>    , UA_Int64     >(uaVariant, QMetaType::LongLong);
-		case UA_TYPES_UINT64:										   
-            return uaVariantToQVariantArray<QList<uint64_t>   , UA_UInt64    >(uaVariant, QMetaType::ULongLong);
-		case UA_TYPES_FLOAT:										   
-            return uaVariantToQVariantArray<QList<float>      , UA_Float     >(uaVariant, QMetaType::Float);
-		case UA_TYPES_DOUBLE:										   
-            return uaVariantToQVariantArray<QList<double>     , UA_Double    >(uaVariant, QMetaType::Double);
-		case UA_TYPES_STRING:										   
-            return uaVariantToQVariantArray<QList<QString>    , UA_String    >(uaVariant, QMetaType::QString);
-		case UA_TYPES_DATETIME:										   
-            return uaVariantToQVariantArray<QList<QDateTime>  , UA_DateTime  >(uaVariant, QMetaType::QDateTime);
-		case UA_TYPES_GUID:											   
-            return uaVariantToQVariantArray<QList<QUuid>      , UA_Guid      >(uaVariant, QMetaType::QUuid);
-		case UA_TYPES_BYTESTRING:
-            return uaVariantToQVariantArray<QList<QByteArray> , UA_ByteString>(uaVariant, QMetaType::QByteArray);
-#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
-		case UA_TYPES_MODELCHANGESTRUCTUREDATATYPE:
-			return uaVariantToQVariantArray<QList<QUaChangeStructureDataType>, UA_ModelChangeStructureDataType>(uaVariant, METATYPE_CHANGESTRUCTUREDATATYPE);
-#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
-		default:
+		auto converter = toQtConverter(uaVariant.type);
+		if (!converter || !converter->list)
+		{
 			Q_ASSERT_X(false, "uaVariantToQVariantArray", "Unsupported datatype");
+			return QVariant();
 		}
-		return QVariant();
+		return converter->list(uaVariant, converter->qtType);
 	}
 
 	QVariant uaVariantToQVariantVector(const UA_Variant & uaVariant)
@@ -940,47 +1183,78 @@ namespace QUaTypesConverter {
 			return QVariant();
 		}
 		// handle array
-		switch (uaVariant.type->typeIndex) {
-		case UA_TYPES_VARIANT:
-            return uaVariantToQVariantArray<QVector<QVariant>   , UA_Variant   >(uaVariant, QMetaType::UnknownType);
-		case UA_TYPES_BOOLEAN:
-            return uaVariantToQVariantArray<QVector<bool>       , UA_Boolean   >(uaVariant, QMetaType::Bool);
-		case UA_TYPES_SBYTE:										   
-            return uaVariantToQVariantArray<QVector<signed char>, UA_SByte     >(uaVariant, QMetaType::SChar);
-		case UA_TYPES_BYTE:											   
-            return uaVariantToQVariantArray<QVector<uchar>      , UA_Byte      >(uaVariant, QMetaType::UChar);
-		case UA_TYPES_INT16:										   
-            return uaVariantToQVariantArray<QVector<qint16>     , UA_Int16     >(uaVariant, QMetaType::Short);
-		case UA_TYPES_UINT16:										   
-            return uaVariantToQVariantArray<QVector<quint16>    , UA_UInt16    >(uaVariant, QMetaType::UShort);
-		case UA_TYPES_INT32:										   
-            return uaVariantToQVariantArray<QVector<qint32>     , UA_Int32     >(uaVariant, QMetaType::Int);
-		case UA_TYPES_UINT32:										   
-            return uaVariantToQVariantArray<QVector<quint32>    , UA_UInt32    >(uaVariant, QMetaType::UInt);
-		case UA_TYPES_INT64:										   
-            return uaVariantToQVariantArray<QVector<int64_t>    , UA_Int64     >(uaVariant, QMetaType::LongLong);
-		case UA_TYPES_UINT64:										   
-            return uaVariantToQVariantArray<QVector<uint64_t>   , UA_UInt64    >(uaVariant, QMetaType::ULongLong);
-		case UA_TYPES_FLOAT:										   
-            return uaVariantToQVariantArray<QVector<float>      , UA_Float     >(uaVariant, QMetaType::Float);
-		case UA_TYPES_DOUBLE:										   
-            return uaVariantToQVariantArray<QVector<double>     , UA_Double    >(uaVariant, QMetaType::Double);
-		case UA_TYPES_STRING:										   
-            return uaVariantToQVariantArray<QVector<QString>    , UA_String    >(uaVariant, QMetaType::QString);
-		case UA_TYPES_DATETIME:										   
-            return uaVariantToQVariantArray<QVector<QDateTime>  , UA_DateTime  >(uaVariant, QMetaType::QDateTime);
-		case UA_TYPES_GUID:											   
-            return uaVariantToQVariantArray<QVector<QUuid>      , UA_Guid      >(uaVariant, QMetaType::QUuid);
-		case UA_TYPES_BYTESTRING:
-            return uaVariantToQVariantArray<QVector<QByteArray> , UA_ByteString>(uaVariant, QMetaType::QByteArray);
-#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
-		case UA_TYPES_MODELCHANGESTRUCTUREDATATYPE:
-			return uaVariantToQVariantArray<QVector<QUaChangeStructureDataType>, UA_ModelChangeStructureDataType>(uaVariant, METATYPE_CHANGESTRUCTUREDATATYPE);
-#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
-		default:
+		auto converter = toQtConverter(uaVariant.type);
+		if (!converter || !converter->vector)
+		{
 			Q_ASSERT_X(false, "uaVariantToQVariantVector", "Unsupported datatype");
+			return QVariant();
+		}
+		return converter->vector(uaVariant, converter->qtType);
+	}
+
+	static QVariant nestQVariantMatrix(const QSequentialIterable & flat, const UA_UInt32 * dims, const size_t & dimsSize, int & index)
+	{
+		QVariantList level;
+		level.reserve(static_cast<int>(dims[0]));
+		for (UA_UInt32 i = 0; i < dims[0]; i++)
+		{
+			level.append(dimsSize == 1 ? flat.at(index++) : nestQVariantMatrix(flat, dims + 1, dimsSize - 1, index));
+		}
+		return level;
+	}
+
+	QVariant uaVariantToQVariantMatrix(const UA_Variant & uaVariant)
+	{
+		Q_ASSERT(uaVariant.arrayDimensionsSize > 1);
+		// shape must match data
+		size_t size = 1;
+		for (size_t i = 0; i < uaVariant.arrayDimensionsSize; i++)
+		{
+			size *= uaVariant.arrayDimensions[i];
+		}
+		if (size != uaVariant.arrayLength)
+		{
+			Q_ASSERT_X(false, "uaVariantToQVariantMatrix", "Array dimensions do not match array length");
+			return uaVariantToQVariantArray(uaVariant);
+		}
+		// convert as one dimensional array, then nest in row-major order
+		QVariant flat = uaVariantToQVariantArray(uaVariant);
+		auto iter  = flat.value<QSequentialIterable>();
+		int  index = 0;
+		return nestQVariantMatrix(iter, uaVariant.arrayDimensions, uaVariant.arrayDimensionsSize, index);
+	}
+
+	// copy a ua array of numbers into a qt container
+	template<typename TARGETTYPE, typename UATYPE>
+	void uaArrayToQContainer(const UATYPE * src, const size_t &size, QVector<TARGETTYPE> &dst)
+	{
+		// contiguous, single bulk copy
+		dst.resize(static_cast<int>(size));
+		numericArrayCopy(dst.data(), src, size);
+	}
+
+	template<typename TARGETTYPE, typename UATYPE>
+	void uaArrayToQContainer(const UATYPE * src, const size_t &size, QList<TARGETTYPE> &dst)
+	{
+		dst.reserve(static_cast<int>(size));
+		for (size_t i = 0; i < size; i++)
+		{
+			dst.append(numericCast<TARGETTYPE, UATYPE>(src[i]));
 		}
-		return QVariant();
+	}
+
+	template<typename ARRAYTYPE, typename UATYPE>
+	bool uaArrayToNumericQContainer(const UATYPE *, const size_t &, ARRAYTYPE &, std::false_type)
+	{
+		return false;
+	}
+
+	template<typename ARRAYTYPE, typename UATYPE>
+	bool uaArrayToNumericQContainer(const UATYPE * src, const size_t &size, ARRAYTYPE &dst, std::true_type)
+	{
+		// NOTE : numeric target types already match the ua type, so no per-element convert is needed
+		uaArrayToQContainer(src, size, dst);
+		return true;
 	}
 
     template <typename ARRAYTYPE, typename UATYPE>
@@ -995,6 +1269,12 @@ namespace QUaTypesConverter {
 		}
 		// get start of array
 		UATYPE *tempSrc = static_cast<UATYPE *>(var.data);
+		// numeric arrays are copied in bulk, without going through per-element variants
+		if (uaArrayToNumericQContainer(tempSrc, var.arrayLength, retList,
+			std::integral_constant<bool, std::is_arithmetic<TARGETTYPE>::value && std::is_arithmetic<UATYPE>::value>()))
+		{
+			return QVariant::fromValue(retList);
+		}
 		// copy array data
 		for (size_t i = 0; i < var.arrayLength; i++) 
 		{
@@ -1065,6 +1345,12 @@ namespace QUaTypesConverter {
 		return epochStart.addMSecs(*data / UA_DATETIME_MSEC).toLocalTime();
 		// TODO : why .toLocalTime() though?
 	}
+	// specialization (QUaDateTime)
+	template<>
+	QUaDateTime uaVariantToQVariantScalar<QUaDateTime, UA_DateTime>(const UA_DateTime *data)
+	{
+		return QUaDateTime(*data);
+	}
 	// specialization (QUuid)
 	template<>
 	QUuid uaVariantToQVariantScalar<QUuid, UA_Guid>(const UA_Guid *data)
@@ -1105,7 +1391,110 @@ namespace QUaTypesConverter {
 		return ret;
 	}
 #endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
-	
+
+	template<typename TARGETTYPE, typename QTTYPE>
+	static void addFromQtConverter(QUaConverterTable &table, const int &qtType, const UA_DataType *uaType, const bool &hasArray = true)
+	{
+		QUaFromQtConverter * converter = nullptr;
+		if (qtType >= QMetaType::User)
+		{
+			Q_ASSERT(qtType - QMetaType::User < QUA_CONVERTER_CUSTOM_TYPES);
+			converter = &table.custom[qtType - QMetaType::User];
+		}
+		else
+		{
+			converter = &table.builtin[qtType];
+		}
+		converter->uaType = uaType;
+		converter->scalar = &uaVariantFromQVariantScalar<TARGETTYPE, QTTYPE>;
+		if (hasArray)
+		{
+			converter->array = &uaVariantFromQVariantArray<TARGETTYPE, QTTYPE>;
+		}
+	}
+
+	template<typename TARGETTYPE, typename UATYPE>
+	static void addToQtConverter(QUaConverterTable &table, const int &typeIndex, const QMetaType::Type &qtType, const bool &hasArray = true)
+	{
+		QUaToQtConverter &converter = table.ua[typeIndex];
+		converter.qtType = qtType;
+		converter.scalar = &uaVariantToQVariantScalar<TARGETTYPE, UATYPE>;
+		if (hasArray)
+		{
+			converter.list   = &uaVariantToQVariantArray<QList<TARGETTYPE>  , UATYPE>;
+			converter.vector = &uaVariantToQVariantArray<QVector<TARGETTYPE>, UATYPE>;
+		}
+	}
+
+	static QUaConverterTable buildConverterTable()
+	{
+		QUaConverterTable table = {};
+		// ua from qt
+		addFromQtConverter<UA_Variant   , QVariant  >(table, QMetaType::UnknownType, &UA_TYPES[UA_TYPES_VARIANT   ]);
+		addFromQtConverter<UA_Boolean   , bool      >(table, QMetaType::Bool       , &UA_TYPES[UA_TYPES_BOOLEAN   ]);
+		addFromQtConverter<UA_SByte     , char      >(table, QMetaType::Char       , &UA_TYPES[UA_TYPES_SBYTE     ]);
+		addFromQtConverter<UA_SByte     , char      >(table, QMetaType::SChar      , &UA_TYPES[UA_TYPES_SBYTE     ]);
+		addFromQtConverter<UA_Byte      , uchar     >(table, QMetaType::UChar      , &UA_TYPES[UA_TYPES_BYTE      ]);
+		addFromQtConverter<UA_Int16     , qint16    >(table, QMetaType::Short      , &UA_TYPES[UA_TYPES_INT16     ]);
+		addFromQtConverter<UA_UInt16    , quint16   >(table, QMetaType::UShort     , &UA_TYPES[UA_TYPES_UINT16    ]);
+		addFromQtConverter<UA_Int32     , qint32    >(table, QMetaType::Int        , &UA_TYPES[UA_TYPES_INT32     ]);
+		addFromQtConverter<UA_UInt32    , quint32   >(table, QMetaType::UInt       , &UA_TYPES[UA_TYPES_UINT32    ]);
+		addFromQtConverter<UA_Int64     , int64_t   >(table, QMetaType::Long       , &UA_TYPES[UA_TYPES_INT64     ]);
+		addFromQtConverter<UA_Int64     , int64_t   >(table, QMetaType::LongLong   , &UA_TYPES[UA_TYPES_INT64     ]);
+		addFromQtConverter<UA_UInt64    , uint64_t  >(table, QMetaType::ULong      , &UA_TYPES[UA_TYPES_UINT64    ]);
+		addFromQtConverter<UA_UInt64    , uint64_t  >(table, QMetaType::ULongLong  , &UA_TYPES[UA_TYPES_UINT64    ]);
+		addFromQtConverter<UA_Float     , float     >(table, QMetaType::Float      , &UA_TYPES[UA_TYPES_FLOAT     ]);
+		addFromQtConverter<UA_Double    , double    >(table, QMetaType::Double     , &UA_TYPES[UA_TYPES_DOUBLE    ]);
+		addFromQtConverter<UA_String    , QString   >(table, QMetaType::QString    , &UA_TYPES[UA_TYPES_STRING    ]);
+		addFromQtConverter<UA_DateTime  , QDateTime >(table, QMetaType::QDateTime  , &UA_TYPES[UA_TYPES_DATETIME  ]);
+		addFromQtConverter<UA_Guid      , QUuid     >(table, QMetaType::QUuid      , &UA_TYPES[UA_TYPES_GUID      ]);
+		addFromQtConverter<UA_ByteString, QByteArray>(table, QMetaType::QByteArray , &UA_TYPES[UA_TYPES_BYTESTRING]);
+		// ua from qt : custom metatypes
+		addFromQtConverter<UA_NodeId       , QString>(table, METATYPE_NODEID       , &UA_TYPES[UA_TYPES_NODEID       ], false);
+		addFromQtConverter<UA_LocalizedText, QString>(table, METATYPE_LOCALIZEDTEXT, &UA_TYPES[UA_TYPES_LOCALIZEDTEXT], false);
+#ifdef UA_TYPES_IMAGEPNG
+		addFromQtConverter<UA_ByteString, QByteArray>(table, METATYPE_IMAGE, &UA_TYPES[UA_TYPES_IMAGEPNG], false);
+#endif
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+		addFromQtConverter<UA_TimeZoneDataType, QTimeZone>(table, METATYPE_TIMEZONEDATATYPE, &UA_TYPES[UA_TYPES_TIMEZONEDATATYPE], false);
+		addFromQtConverter<UA_ModelChangeStructureDataType, QUaChangeStructureDataType>(table, METATYPE_CHANGESTRUCTUREDATATYPE, &UA_TYPES[UA_TYPES_MODELCHANGESTRUCTUREDATATYPE]);
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+		// ua to qt
+		addToQtConverter<QVariant   , UA_Variant   >(table, UA_TYPES_VARIANT   , QMetaType::UnknownType);
+		addToQtConverter<bool       , UA_Boolean   >(table, UA_TYPES_BOOLEAN   , QMetaType::Bool       );
+		addToQtConverter<signed char, UA_SByte     >(table, UA_TYPES_SBYTE     , QMetaType::SChar      );
+		addToQtConverter<uchar      , UA_Byte      >(table, UA_TYPES_BYTE      , QMetaType::UChar      );
+		addToQtConverter<qint16     , UA_Int16     >(table, UA_TYPES_INT16     , QMetaType::Short      );
+		addToQtConverter<quint16    , UA_UInt16    >(table, UA_TYPES_UINT16    , QMetaType::UShort     );
+		addToQtConverter<qint32     , UA_Int32     >(table, UA_TYPES_INT32     , QMetaType::Int        );
+		addToQtConverter<quint32    , UA_UInt32    >(table, UA_TYPES_UINT32    , QMetaType::UInt       );
+		addToQtConverter<int64_t    , UA_Int64     >(table, UA_TYPES_INT64     , QMetaType::LongLong   );
+		addToQtConverter<uint64_t   , UA_UInt64    >(table, UA_TYPES_UINT64    , QMetaType::ULongLong  );
+		addToQtConverter<float      , UA_Float     >(table, UA_TYPES_FLOAT     , QMetaType::Float      );
+		addToQtConverter<double     , UA_Double    >(table, UA_TYPES_DOUBLE    , QMetaType::Double     );
+		addToQtConverter<QString    , UA_String    >(table, UA_TYPES_STRING    , QMetaType::QString    );
+		addToQtConverter<QDateTime  , UA_DateTime  >(table, UA_TYPES_DATETIME  , QMetaType::QDateTime  );
+		addToQtConverter<QUuid      , UA_Guid      >(table, UA_TYPES_GUID      , QMetaType::QUuid      );
+		addToQtConverter<QByteArray , UA_ByteString>(table, UA_TYPES_BYTESTRING, QMetaType::QByteArray );
+		// NOTE : typedef UA_DateTime UA_UtcTime;
+		addToQtConverter<QDateTime  , UA_DateTime  >(table, UA_TYPES_UTCTIME   , QMetaType::QDateTime, false);
+		// ua to qt : custom metatypes
+		addToQtConverter<QString, UA_NodeId       >(table, UA_TYPES_NODEID       , METATYPE_NODEID       , false);
+		addToQtConverter<QString, UA_LocalizedText>(table, UA_TYPES_LOCALIZEDTEXT, METATYPE_LOCALIZEDTEXT, false);
+#ifdef UA_ENABLE_SUBSCRIPTIONS_EVENTS
+		addToQtConverter<QTimeZone, UA_TimeZoneDataType>(table, UA_TYPES_TIMEZONEDATATYPE, METATYPE_TIMEZONEDATATYPE, false);
+		addToQtConverter<QUaChangeStructureDataType, UA_ModelChangeStructureDataType>(table, UA_TYPES_MODELCHANGESTRUCTUREDATATYPE, METATYPE_CHANGESTRUCTUREDATATYPE);
+#endif // UA_ENABLE_SUBSCRIPTIONS_EVENTS
+		return table;
+	}
+
+	static const QUaConverterTable & converterTable()
+	{
+		// NOTE : thread-safe initialization, read-only afterwards
+		static const QUaConverterTable table = buildConverterTable();
+		return table;
+	}
+
 }
 
 QT_END_NAMESPACE
@@ -2,6 +2,11 @@
 #define QUATYPESCONVERTER_H
 
 #include <QUaCustomDataTypes>
+#include <type_traits>
+#include <cstring>
+
+// default number of entries of each string conversion cache (per thread)
+#define QUA_CONVERTER_CACHE_CAPACITY 4096
 
 QT_BEGIN_NAMESPACE
 
@@ -16,11 +21,30 @@ namespace QUaTypesConverter {
 	
 	QString   uaStringToQString  (const UA_String &string);
 	UA_String uaStringFromQString(const QString &uaString);
+	// NOTE : namespace index is ignored when converting to string
+	QString          uaQualifiedNameToQString  (const UA_QualifiedName &qualifiedName);
+	UA_QualifiedName uaQualifiedNameFromQString(const QString &name, const quint16 &namespaceIndex = 1);
+
+	// conversion caches for node ids and qualified names, confined to the calling thread
+	// and bounded to capacity entries each (least recently used are evicted first)
+	// capacity 0 disables caching
+	int  conversionCacheCapacity();
+	void setConversionCacheCapacity(const int &capacity);
+	// remove node id from the cache of the calling thread (e.g. when node is deleted)
+	// NOTE : the conversion does not depend on the node, so entries of other threads stay
+	//        correct and are just evicted when least recently used
+	void removeNodeIdFromCache(const UA_NodeId &nodeId);
+	// clear the caches of the calling thread
+	void clearConversionCache();
+	// metatype id of QUaDateTime, set once it is registered by the server
+	void setDateTimeTypeId(const int &typeId);
 
 	// qt supported
 	bool            isQTypeArray    (const QMetaType::Type &type);
 	QMetaType::Type getQArrayType   (const QMetaType::Type &type);
 	bool            isSupportedQType(const QMetaType::Type &type);
+	// dimensions of (nested) lists, taken from the first element of each level, empty if scalar
+	QVector<quint32> getQVariantDimensions(const QVariant &var, QMetaType::Type *leafType = nullptr);
 	// ua from c++
 	template<typename T>
 	UA_NodeId uaTypeNodeIdFromCpp();
@@ -44,6 +68,11 @@ namespace QUaTypesConverter {
 	UA_Variant uaVariantFromQVariantArray(const QVariant &var, const UA_DataType *type);
 	template<> // TODO : implement better
 	UA_Variant uaVariantFromQVariantArray<UA_Variant, QVariant>(const QVariant & var, const UA_DataType * type);
+	// ua from qt : multidimensional array (nested lists, must be rectangular)
+	UA_Variant uaVariantFromQVariantMatrix(const QVariant &var, QMetaType::Type qtType = QMetaType::UnknownType);
+	// ua from contiguous numeric buffer in row-major order (last dimension varies fastest)
+	template<typename T>
+	UA_Variant uaVariantFromBuffer(const T *data, const QVector<quint32> &arrayDimensions);
 
 	// ua to qt
 	QMetaType::Type uaTypeNodeIdToQType(const UA_NodeId   *nodeId   );
@@ -68,9 +97,127 @@ namespace QUaTypesConverter {
 		                               const ArrayType  &arrType = ArrayType::QList);
 	QVariant uaVariantToQVariantList  (const UA_Variant &uaVariant);
 	QVariant uaVariantToQVariantVector(const UA_Variant &uaVariant);
+	// ua to qt : multidimensional array (nested QVariantList)
+	QVariant uaVariantToQVariantMatrix(const UA_Variant &uaVariant);
     template <typename ARRAYTYPE, typename UATYPE>
 	QVariant uaVariantToQVariantArray (const UA_Variant &var, QMetaType::Type type);
 
+	// bulk copy between contiguous numeric buffers (widening, narrowing or same type)
+	template<typename DSTTYPE, typename SRCTYPE>
+	void numericArrayCopy(DSTTYPE *dst, const SRCTYPE *src, const size_t &size);
+
+	// same representation on both sides (e.g. qint64 and UA_Int64), a plain memory copy
+	template<typename DSTTYPE, typename SRCTYPE>
+	struct isBitwiseCopyable : std::integral_constant<bool,
+		std::is_same<DSTTYPE, SRCTYPE>::value ||
+		(std::is_integral<DSTTYPE>::value && std::is_integral<SRCTYPE>::value &&
+		 sizeof(DSTTYPE) == sizeof(SRCTYPE) && std::is_signed<DSTTYPE>::value == std::is_signed<SRCTYPE>::value)>
+	{};
+
+	// floating point to integer rounds like QVariant::convert does
+	template<typename DSTTYPE, typename SRCTYPE>
+	struct isRoundedCast : std::integral_constant<bool,
+		std::is_floating_point<SRCTYPE>::value && std::is_integral<DSTTYPE>::value && !std::is_same<DSTTYPE, bool>::value>
+	{};
+
+	template<typename DSTTYPE, typename SRCTYPE>
+	inline DSTTYPE numericCast(const SRCTYPE &src, std::true_type)
+	{
+		return static_cast<DSTTYPE>(qRound64(src));
+	}
+
+	template<typename DSTTYPE, typename SRCTYPE>
+	inline DSTTYPE numericCast(const SRCTYPE &src, std::false_type)
+	{
+		return static_cast<DSTTYPE>(src);
+	}
+
+	template<typename DSTTYPE, typename SRCTYPE>
+	inline DSTTYPE numericCast(const SRCTYPE &src)
+	{
+		return numericCast<DSTTYPE, SRCTYPE>(src, isRoundedCast<DSTTYPE, SRCTYPE>());
+	}
+
+	template<typename DSTTYPE, typename SRCTYPE>
+	inline void numericArrayCopy(DSTTYPE *dst, const SRCTYPE *src, const size_t &size, std::true_type)
+	{
+		std::memcpy(dst, src, size * sizeof(DSTTYPE));
+	}
+
+	template<typename DSTTYPE, typename SRCTYPE>
+	inline void numericArrayCopy(DSTTYPE *dst, const SRCTYPE *src, const size_t &size, std::false_type)
+	{
+		// NOTE : tight loop without aliasing so the compiler can vectorize it for the target
+		for (size_t i = 0; i < size; i++)
+		{
+			dst[i] = numericCast<DSTTYPE, SRCTYPE>(src[i]);
+		}
+	}
+
+	template<typename DSTTYPE, typename SRCTYPE>
+	inline void numericArrayCopy(DSTTYPE *dst, const SRCTYPE *src, const size_t &size)
+	{
+		static_assert(std::is_arithmetic<DSTTYPE>::value && std::is_arithmetic<SRCTYPE>::value,
+			"numericArrayCopy : only numeric types supported");
+		if (size == 0)
+		{
+			return;
+		}
+		numericArrayCopy(dst, src, size, isBitwiseCopyable<DSTTYPE, SRCTYPE>());
+	}
+
+	// fixed width counterpart of a numeric type, so long or char map to the ua type of their actual width
+	template<typename T, bool = std::is_integral<T>::value && !std::is_same<T, bool>::value>
+	struct fixedWidthType
+	{
+		typedef T type;
+	};
+
+	template<typename T>
+	struct fixedWidthType<T, true>
+	{
+		typedef typename std::conditional<sizeof(T) == 1, typename std::conditional<std::is_signed<T>::value, qint8 , quint8 >::type,
+			    typename std::conditional<sizeof(T) == 2, typename std::conditional<std::is_signed<T>::value, qint16, quint16>::type,
+			    typename std::conditional<sizeof(T) == 4, typename std::conditional<std::is_signed<T>::value, qint32, quint32>::type,
+			                                              typename std::conditional<std::is_signed<T>::value, qint64, quint64>::type
+			>::type>::type>::type type;
+	};
+
+	template<typename T>
+	UA_Variant uaVariantFromBuffer(const T *data, const QVector<quint32> &arrayDimensions)
+	{
+		static_assert(std::is_arithmetic<T>::value, "uaVariantFromBuffer : only numeric types supported");
+		UA_Variant retVar;
+		UA_Variant_init(&retVar);
+		size_t size = arrayDimensions.isEmpty() ? 0 : 1;
+		for (int i = 0; i < arrayDimensions.size(); i++)
+		{
+			size *= arrayDimensions.at(i);
+		}
+		if (size == 0)
+		{
+			return retVar;
+		}
+		typedef typename fixedWidthType<T>::type FixedType;
+		auto type = uaTypeFromQType(static_cast<QMetaType::Type>(qMetaTypeId<FixedType>()));
+		Q_CHECK_PTR(type);
+		if (!type)
+		{
+			return retVar;
+		}
+		// NOTE : numeric ua types have the same representation as their fixed width counterparts
+		Q_ASSERT(type->memSize == sizeof(FixedType));
+		FixedType * arr = static_cast<FixedType *>(UA_Array_new(size, type));
+		numericArrayCopy(arr, data, size);
+		UA_Variant_setArray(&retVar, arr, size, type);
+		// set shape
+		const size_t dimsSize = static_cast<size_t>(arrayDimensions.size());
+		retVar.arrayDimensions     = static_cast<UA_UInt32 *>(UA_Array_new(dimsSize, &UA_TYPES[UA_TYPES_UINT32]));
+		retVar.arrayDimensionsSize = dimsSize;
+		numericArrayCopy(retVar.arrayDimensions, arrayDimensions.constData(), dimsSize);
+		return retVar;
+	}
+
 	template<typename T>
 	UA_NodeId uaTypeNodeIdFromCpp()
 	{
@@ -130,7 +277,7 @@ namespace QUaTypesConverter {
 		{
 			return UA_NODEID_NUMERIC(0, UA_NS0ID_STRING);
 		}
-		else if (std::is_same<T, QDateTime>::value)
+		else if (std::is_same<T, QDateTime>::value || std::is_same<T, QUaDateTime>::value)
 		{
 			return UA_NODEID_NUMERIC(0, UA_NS0ID_DATETIME);
 		}
@@ -211,7 +358,7 @@ namespace QUaTypesConverter {
 		{
 			return QMetaType::QString;
 		}
-		else if (std::is_same<T, QDateTime>::value)
+		else if (std::is_same<T, QDateTime>::value || std::is_same<T, QUaDateTime>::value)
 		{
 			return QMetaType::QDateTime;
 		}
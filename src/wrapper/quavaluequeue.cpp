@@ -0,0 +1,164 @@
+#include "quavaluequeue.h"
+
+QUaValueUpdate::QUaValueUpdate()
+	: value(), sourceTimestamp(0)
+{
+	UA_NodeId_init(&nodeId);
+}
+
+QUaValueUpdate::QUaValueUpdate(const UA_NodeId & nodeId, const QVariant & value, const UA_DateTime & sourceTimestamp)
+	: value(value), sourceTimestamp(sourceTimestamp)
+{
+	auto st = UA_NodeId_copy(&nodeId, &this->nodeId);
+	Q_ASSERT(st == UA_STATUSCODE_GOOD);
+	Q_UNUSED(st);
+}
+
+QUaValueUpdate::QUaValueUpdate(QUaValueUpdate && other)
+	: nodeId(other.nodeId), value(std::move(other.value)), sourceTimestamp(other.sourceTimestamp)
+{
+	// take ownership of node id memory
+	UA_NodeId_init(&other.nodeId);
+}
+
+QUaValueUpdate & QUaValueUpdate::operator=(QUaValueUpdate && other)
+{
+	if (this == &other)
+	{
+		return *this;
+	}
+	UA_NodeId_clear(&nodeId);
+	// take ownership of node id memory
+	nodeId          = other.nodeId;
+	value           = std::move(other.value);
+	sourceTimestamp = other.sourceTimestamp;
+	UA_NodeId_init(&other.nodeId);
+	return *this;
+}
+
+QUaValueUpdate::~QUaValueUpdate()
+{
+	UA_NodeId_clear(&nodeId);
+}
+
+QUaValueQueue::QUaValueQueue(const quint32 &capacity/* = 4096*/)
+{
+	Q_ASSERT_X(capacity > 1, "QUaValueQueue::QUaValueQueue", "Capacity must be greater than one.");
+	// round up to power of two so position can be masked
+	size_t size = 2;
+	while (size < capacity)
+	{
+		size <<= 1;
+	}
+	m_cells = new Cell[size];
+	m_mask  = size - 1;
+	for (size_t i = 0; i < size; i++)
+	{
+		m_cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	m_enqueuePos.store(0, std::memory_order_relaxed);
+	m_dequeuePos.store(0, std::memory_order_relaxed);
+	this->resetStats();
+}
+
+QUaValueQueue::~QUaValueQueue()
+{
+	delete[] m_cells;
+}
+
+bool QUaValueQueue::enqueue(QUaValueUpdate &&update)
+{
+	Cell * cell;
+	size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		cell = &m_cells[pos & m_mask];
+		size_t seq = cell->sequence.load(std::memory_order_acquire);
+		intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+		// cell free, try to claim it
+		if (diff == 0)
+		{
+			if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		// cell not yet consumed, queue is full
+		else if (diff < 0)
+		{
+			m_dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		// other producer claimed it, reload
+		else
+		{
+			pos = m_enqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+	cell->update = std::move(update);
+	cell->sequence.store(pos + 1, std::memory_order_release);
+	m_enqueued.fetch_add(1, std::memory_order_relaxed);
+	// update high watermark
+	// NOTE : consumer might already be past pos, so clamp like size does
+	quint32 curSize = this->size();
+	quint32 maxSize = m_highWatermark.load(std::memory_order_relaxed);
+	while (curSize > maxSize &&
+		!m_highWatermark.compare_exchange_weak(maxSize, curSize, std::memory_order_relaxed))
+	{
+	}
+	return true;
+}
+
+bool QUaValueQueue::dequeue(QUaValueUpdate &update)
+{
+	// NOTE : single consumer, so no need to compare and swap the position
+	size_t pos  = m_dequeuePos.load(std::memory_order_relaxed);
+	Cell * cell = &m_cells[pos & m_mask];
+	size_t seq  = cell->sequence.load(std::memory_order_acquire);
+	if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0)
+	{
+		return false;
+	}
+	update = std::move(cell->update);
+	// release any remaining resources before handing cell back to producers
+	cell->update = QUaValueUpdate();
+	cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+	m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+	m_drained.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+quint32 QUaValueQueue::capacity() const
+{
+	return static_cast<quint32>(m_mask + 1);
+}
+
+quint32 QUaValueQueue::size() const
+{
+	size_t enqPos = m_enqueuePos.load(std::memory_order_relaxed);
+	size_t deqPos = m_dequeuePos.load(std::memory_order_relaxed);
+	return enqPos > deqPos ? static_cast<quint32>(enqPos - deqPos) : 0;
+}
+
+bool QUaValueQueue::isEmpty() const
+{
+	return this->size() == 0;
+}
+
+QUaValueQueueStats QUaValueQueue::stats() const
+{
+	return {
+		m_enqueued.load(std::memory_order_relaxed),
+		m_dropped.load(std::memory_order_relaxed),
+		m_drained.load(std::memory_order_relaxed),
+		m_highWatermark.load(std::memory_order_relaxed)
+	};
+}
+
+void QUaValueQueue::resetStats()
+{
+	m_enqueued.store(0, std::memory_order_relaxed);
+	m_dropped.store(0, std::memory_order_relaxed);
+	m_drained.store(0, std::memory_order_relaxed);
+	m_highWatermark.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,89 @@
+#ifndef QUAVALUEQUEUE_H
+#define QUAVALUEQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+
+#include <QVariant>
+
+#include <open62541.h>
+
+// size used to keep producer and consumer positions in separate cache lines
+#define QUA_CACHE_LINE_SIZE 64
+
+// Value update to be applied by the server thread
+// NOTE : owns a copy of the node id, so producers never touch the variable QObject
+struct QUaValueUpdate
+{
+	QUaValueUpdate();
+	QUaValueUpdate(const UA_NodeId &nodeId, const QVariant &value, const UA_DateTime &sourceTimestamp);
+	QUaValueUpdate(QUaValueUpdate &&other);
+	QUaValueUpdate &operator=(QUaValueUpdate &&other);
+	~QUaValueUpdate();
+
+	UA_NodeId   nodeId;
+	QVariant    value;
+	UA_DateTime sourceTimestamp; // 0 if not set
+
+private:
+	Q_DISABLE_COPY(QUaValueUpdate)
+};
+
+// Counters of the value update queue
+struct QUaValueQueueStats
+{
+	quint64 enqueued;      // updates accepted
+	quint64 dropped;       // updates rejected because queue was full
+	quint64 drained;       // updates taken by the server thread
+	quint32 highWatermark; // max number of updates waiting at the same time
+};
+
+// Bounded lock-free multi-producer single-consumer queue (ring buffer with per-cell sequence numbers)
+// enqueue can be called from any thread, dequeue only from the server thread
+class QUaValueQueue
+{
+public:
+	// capacity is rounded up to the next power of two
+	explicit QUaValueQueue(const quint32 &capacity = 4096);
+	~QUaValueQueue();
+
+	// returns false if the queue is full, the update is then dropped and counted
+	bool enqueue(QUaValueUpdate &&update);
+	// returns false if the queue is empty
+	bool dequeue(QUaValueUpdate &update);
+
+	quint32 capacity() const;
+	// approximate number of updates waiting
+	quint32 size() const;
+	bool    isEmpty() const;
+
+	QUaValueQueueStats stats() const;
+	void               resetStats();
+
+private:
+	Q_DISABLE_COPY(QUaValueQueue)
+
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		QUaValueUpdate      update;
+	};
+
+	Cell   * m_cells;
+	size_t   m_mask;
+	// producers and consumer positions in separate cache lines
+	// NOTE : explicit padding instead of alignas, plain new does not honour
+	//        over-aligned types before C++17
+	char                 m_pad0[QUA_CACHE_LINE_SIZE];
+	std::atomic<size_t>  m_enqueuePos;
+	char                 m_pad1[QUA_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+	std::atomic<size_t>  m_dequeuePos;
+	char                 m_pad2[QUA_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+	// stats
+	std::atomic<quint64> m_enqueued;
+	std::atomic<quint64> m_dropped;
+	std::atomic<quint64> m_drained;
+	std::atomic<quint32> m_highWatermark;
+};
+
+#endif // QUAVALUEQUEUE_H